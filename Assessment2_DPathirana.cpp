@@ -1,137 +1,272 @@
 #include <TL-Engine.h>
 
-using namespace tle;
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "Culling.h"
+#include "GameMath.h"
+#include "GameWorld.h"
+#include "ParticleSystem.h"
+#include "Telemetry.h"
+#include "TuningConfig.h"
 
-// Struct to represent a 3D vector with x, y, and z components
-struct Vector3 {
-    float x, y, z;
-};
+using namespace tle;
 
-// Struct to represent a bounding box with min and max values along x, y, and z axes
-struct BoundingBox {
-    float minX;
-    float maxX;
-    float minY;
-    float maxY;
-    float minZ;
-    float maxZ;
+// Struct to hold the culling state of a model. A culled model is removed from its mesh so it is not drawn at all,
+// and its matrix is kept so the model made again when it comes back into view is turned and scaled the same.
+struct CullState {
+    int cullId;
+    IMesh* mesh;
+    bool hidden = false;
+    float savedMatrix[4][4];
 };
 
-// Struct to represent Enemy Cars
+// Struct to hold the models of an Enemy Car, its gameplay state lives in the GameWorld
 struct EnemyCars {
 
-    // Models
+    // Models, the sphere is attached to the car and culled along with it
     IModel* enemyCarModel;
     IModel* sphereModel;
 
-    // Movement speeds
-    const float carMovementSpeed = 30 * 0.5;
-    float sphereMovementSpeed = 2.5;
+    // Skin set on the sphere, kept so a sphere made again after culling still shows the car was hit
+    std::string sphereSkin;
 
-    // Flags for car and sphere status
-    bool carHitStatus = false;
-    bool carSideHit = false;
-    bool carMovementStatus = true;
-    bool sphereMovementStatus = true;
+    // Culling
+    CullState cullState;
+
+    // Scale the car was squashed by when it was hit, kept so a tuning reload cannot stop restart undoing it
+    float squashScale = 1.0f;
 };
 
-// Calculate the dot product of two 3D vectors
-float calculateDotProduct(Vector3 v, Vector3 w) {
-    return (v.x * w.x + v.y * w.y + v.z * w.z);
+// Take a culled model out of the scene, or make it again from its mesh where it was when it comes back into view
+void setModelCulled(IModel*& model, CullState& state, bool hidden) {
+    if (state.hidden == hidden) {
+        return;
+    }
+
+    if (hidden) {
+        model->GetMatrix(&state.savedMatrix[0][0]);
+        state.mesh->RemoveModel(model);
+        model = nullptr;
+    }
+    else {
+        model = state.mesh->CreateModel();
+        model->SetMatrix(&state.savedMatrix[0][0]);
+    }
+    state.hidden = hidden;
+}
+
+// Cull an enemy car together with its sphere, a car coming back into view is put where the world has it now
+void setEnemyCulled(EnemyCars& car, IMesh* sphereMesh, const EnemyCar& enemy, bool hidden) {
+    if (car.cullState.hidden == hidden) {
+        return;
+    }
+
+    if (hidden) {
+        sphereMesh->RemoveModel(car.sphereModel);
+        car.sphereModel = nullptr;
+        setModelCulled(car.enemyCarModel, car.cullState, true);
+        return;
+    }
+
+    setModelCulled(car.enemyCarModel, car.cullState, false);
+    car.enemyCarModel->SetPosition(enemy.position.x, enemy.position.y, enemy.position.z);
+    car.sphereModel = sphereMesh->CreateModel(0, enemy.sphereHeight, 0);
+    if (!car.sphereSkin.empty()) {
+        car.sphereModel->SetSkin(car.sphereSkin);
+    }
+    car.sphereModel->AttachToParent(car.enemyCarModel);
 }
 
-// Calculate the modulus (magnitude) of a 3D vector
-float calculateModulus(Vector3 v) {
-    return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+// Apply a change of visibility from the culling grid. Ids are handed out to the trees first, then to the static
+// enemies and then to the moving enemies.
+void setCullObjectHidden(int id, bool hidden, std::vector<IModel*>& trees, std::vector<CullState>& treeCullStates,
+                         EnemyCars staticEnemies[], EnemyCars movingEnemies[], IMesh* sphereMesh, const GameWorld& world) {
+    const int noOfTrees = int(trees.size());
+    if (id < noOfTrees) {
+        setModelCulled(trees[id], treeCullStates[id], hidden);
+    }
+    else if (id < noOfTrees + numStaticEnemies) {
+        int i = id - noOfTrees;
+        setEnemyCulled(staticEnemies[i], sphereMesh, world.GetStaticEnemy(i), hidden);
+    }
+    else {
+        int i = id - noOfTrees - numStaticEnemies;
+        setEnemyCulled(movingEnemies[i], sphereMesh, world.GetMovingEnemy(i), hidden);
+    }
 }
 
-// Calculate the facing vector of a model by moving it forward and recording the change in position
-void calculateFacingVector(IModel* model, Vector3& facingVector) {
-    Vector3 initialPos = { model->GetX(), model->GetY(), model->GetZ() };
-    model->MoveLocalZ(1.0f);
-    Vector3 finalPos = { model->GetX(), model->GetY(), model->GetZ() };
-    facingVector = { finalPos.x - initialPos.x, finalPos.y - initialPos.y, finalPos.z - initialPos.z };
-    model->MoveLocalZ(-1.0f);
+// Half the width of the square the culling grid covers. It reaches every tree, every static enemy and the whole
+// road the moving enemies drive along, so no object is squeezed into an edge cell.
+float calculateCullGridExtent(const GameWorld& world, const GameSettings& settings) {
+    float extent = 0.0f;
+    for (const Vector3& tree : world.GetTrees()) {
+        extent = std::max(extent, std::max(std::fabs(tree.x), std::fabs(tree.z)));
+    }
+    for (int i = 0; i < numStaticEnemies; i++) {
+        const Vector3& position = world.GetStaticEnemy(i).position;
+        extent = std::max(extent, std::max(std::fabs(position.x), std::fabs(position.z)));
+    }
+    for (int i = 0; i < numMovingEnemies; i++) {
+        const Vector3& position = world.GetMovingEnemy(i).position;
+        extent = std::max(extent, std::max(std::max(std::fabs(position.x), settings.movingCarRange), std::fabs(position.z)));
+    }
+    return extent;
 }
 
-// Calculate the vector from an enemy car to the player's car
-void calculateEnemyCarToJeepVector(IModel* model, IModel* player, Vector3& enemyCarToJeepVector) {
+// Change the skin of an enemy's sphere, a culled sphere is given it when it is made again
+void setSphereSkin(EnemyCars& car, const std::string& skin) {
+    car.sphereSkin = skin;
+    if (car.sphereModel != nullptr) {
+        car.sphereModel->SetSkin(skin);
+    }
+}
 
-    enemyCarToJeepVector = { player->GetX() - model->GetX(),
-                             player->GetY() - model->GetY(),
-                             player->GetZ() - model->GetZ() };
+// Scale one local axis of a model, a culled model has the scale applied to its saved matrix instead
+void scaleModelAxis(IModel* model, CullState& state, int axis, float factor) {
+    if (state.hidden) {
+        state.savedMatrix[axis][0] *= factor;
+        state.savedMatrix[axis][1] *= factor;
+        state.savedMatrix[axis][2] *= factor;
+        return;
+    }
 
+    float matrix[4][4];
+    model->GetMatrix(&matrix[0][0]);
+    matrix[axis][0] *= factor;
+    matrix[axis][1] *= factor;
+    matrix[axis][2] *= factor;
+    model->SetMatrix(&matrix[0][0]);
 }
 
-// Check for collision between the player's car and an enemy car using bounding box and player's car radius
-bool CheckCollision(IModel* playerCar, IModel* enemyCar, float playerCarRadius, const BoundingBox& box) {
+// Start a burst of sparks, plus debris for heavier impacts, at a collision point
+void spawnImpactParticles(ParticleSystem& particles, const Vector3& impactPoint, const EmitterSettings& sparks,
+                          const EmitterSettings* debris) {
+    particles.StartEmitter(sparks, impactPoint);
+    if (debris != nullptr) {
+        particles.StartEmitter(*debris, impactPoint);
+    }
+}
+
+// Settings for one particle pool, the budgets are fixed limits and how the particles move comes from the tuning values
+ParticlePoolSettings makeParticlePoolSettings(const GameSettings& settings, ParticleKind kind, int capacity, int maxDrawn) {
+    if (kind == PARTICLE_SPARK) {
+        return { capacity, maxDrawn, settings.particleGravity, settings.sparkDrag, settings.sparkRestitution, settings.groundYPosition };
+    }
+    return { capacity, maxDrawn, settings.particleGravity, settings.debrisDrag, settings.debrisRestitution, settings.groundYPosition };
+}
+
+// Struct to hold the emitters started by hits on trees and cars
+struct ImpactEmitters {
+    EmitterSettings treeSparks;
+    EmitterSettings treeDebris;
+    EmitterSettings carSparks;
+    EmitterSettings carDebris;
+};
 
-    // Calculate the min and max bounds of the bounding box, considering the player's car radius
-    float boxminX = (enemyCar->GetLocalX() + box.minX) - playerCarRadius;
-    float boxmaxX = (enemyCar->GetLocalX() + box.maxX) + playerCarRadius;
-    float boxminY = (enemyCar->GetLocalY() + box.minY) - playerCarRadius;
-    float boxmaxY = (enemyCar->GetLocalY() + box.maxY) + playerCarRadius;
-    float boxminZ = (enemyCar->GetLocalZ() + box.minZ) - playerCarRadius;
-    float boxmaxZ = (enemyCar->GetLocalZ() + box.maxZ) + playerCarRadius;
+ImpactEmitters makeImpactEmitters(const GameSettings& settings) {
+    return {
+        { PARTICLE_SPARK, settings.treeSparkDuration, settings.treeSparkRate, settings.treeSparkSpeed,
+          settings.treeSparkSpread, settings.treeSparkUpwardBias, settings.treeSparkLifetime },
+        { PARTICLE_DEBRIS, settings.treeDebrisDuration, settings.treeDebrisRate, settings.treeDebrisSpeed,
+          settings.treeDebrisSpread, settings.treeDebrisUpwardBias, settings.treeDebrisLifetime },
+        { PARTICLE_SPARK, settings.carSparkDuration, settings.carSparkRate, settings.carSparkSpeed,
+          settings.carSparkSpread, settings.carSparkUpwardBias, settings.carSparkLifetime },
+        { PARTICLE_DEBRIS, settings.carDebrisDuration, settings.carDebrisRate, settings.carDebrisSpeed,
+          settings.carDebrisSpread, settings.carDebrisUpwardBias, settings.carDebrisLifetime }
+    };
+}
 
-    // Get the position of the player's car
-    float playerX = playerCar->GetX();
-    float playerY = playerCar->GetY();
-    float playerZ = playerCar->GetZ();
+// Move the pooled particle models onto the particles picked for drawing and park the models left over
+void drawParticleBatch(const ParticleDrawBatch& batch, IModel* models[], int& modelsInUse, float hiddenY) {
+    for (int i = 0; i < batch.count; i++) {
+        models[i]->SetPosition(batch.positions[i].x, batch.positions[i].y, batch.positions[i].z);
+    }
 
-    // Check for collision using bounding box and player's car position
-    bool isCollision = (playerX > boxminX && playerX < boxmaxX&&
-        playerY > boxminY && playerY < boxmaxY&&
-        playerZ > boxminZ && playerZ < boxmaxZ);
+    for (int i = batch.count; i < modelsInUse; i++) {
+        models[i]->SetPosition(0, hiddenY, 0);
+    }
 
-    return isCollision;
+    modelsInUse = batch.count;
 }
 
+// Copy the player's position, heading and wheel animation from the world onto its model
+void syncPlayerModel(const GameWorld& world, IModel* playerCarModel, ISceneNode* frontWheelNodes[], ISceneNode* backWheelNodes[]) {
+    const PlayerCar& player = world.GetPlayer();
+
+    playerCarModel->SetPosition(player.position.x, player.position.y, player.position.z);
+    playerCarModel->ResetOrientation();
+    playerCarModel->RotateY(player.rotationY);
+
+    for (int i = 0; i < 2; i++) {
+        backWheelNodes[i]->RotateLocalX(world.GetWheelSpinAngle());
+    }
+
+    for (int i = 0; i < 2; i++) {
+        frontWheelNodes[i]->RotateLocalX(world.GetWheelSpinAngle());
+        if (world.GetWheelSteerChange() != 0.0f) {
+            frontWheelNodes[i]->RotateY(world.GetWheelSteerChange());
+        }
+    }
+}
+
+// Copy the enemy car positions and sphere heights from the world onto their models, culled cars have no models
+void syncEnemyModels(const GameWorld& world, EnemyCars staticEnemies[], EnemyCars movingEnemies[]) {
+    for (int i = 0; i < numStaticEnemies; i++) {
+        if (staticEnemies[i].cullState.hidden) {
+            continue;
+        }
+        const EnemyCar& enemy = world.GetStaticEnemy(i);
+        staticEnemies[i].enemyCarModel->SetPosition(enemy.position.x, enemy.position.y, enemy.position.z);
+    }
+
+    for (int i = 0; i < numMovingEnemies; i++) {
+        if (movingEnemies[i].cullState.hidden) {
+            continue;
+        }
+        const EnemyCar& enemy = world.GetMovingEnemy(i);
+        movingEnemies[i].enemyCarModel->SetPosition(enemy.position.x, enemy.position.y, enemy.position.z);
+        movingEnemies[i].sphereModel->SetLocalPosition(0, enemy.sphereHeight, 0);
+    }
+}
 
 void main() {
 
+    // Tuning values, read from tuning.cfg and reloaded while the game runs when the file changes
+#ifdef GAME_TUNING_BAKED
+    const GameSettings gameSettings;
+#else
+    const std::string tuningConfigPath = "tuning.cfg";
+    GameSettings gameSettings;
+    std::string tuningErrors;
+    {
+        GameSettings loadedSettings;
+        if (loadTuningConfig(tuningConfigPath, loadedSettings, tuningErrors)) {
+            gameSettings = loadedSettings;
+        }
+    }
+    TuningWatcher tuningWatcher(tuningConfigPath);
+    tuningWatcher.Start();
+    const int tuningTextX = 10;
+    const int tuningTextY = 210;
+#endif
+
     // Constants, Variables, defining initial game state and parameters
-    const float groundYPosition = 0.0f;
     const float skyYPosition = -960.0f;
-    const float playerCarYPosition = 0.0f;
-    const float wheelYPosition = 0.0f;
-    const float enemySphereYPosition = 2.5f;
-    const float cameraXPosition = 0.0f;
-    const float cameraYPosition = 15.0f;
-    const float cameraZPosition = -60.0f;
-    const float cameraRotationX = 15.0f;
+    const float enemySphereYPosition = gameSettings.enemySphereYPosition;
     const float backdropWidth = 305.0f;
     const float backdropHeight = 659.0f;
-    const float perimeterRadius = 50.0f;
-    const int numStaticEnemies = 4;
-    const int numMovingEnemies = 4;
-    const int noOfTrees = 160;
-
-    const float cameraDefaultX = 0.0f;
-    const float cameraDefaultY = 15.0f;
-    const float cameraDefaultZ = -60.0f;
-    const float cameraAttachedX = 0.0f;
-    const float cameraAttachedY1 = 5.0f;
-    const float cameraAttachedY2 = 2.0f;
-    const float cameraAttachedZ = -15.0f;
+
     const int scoreX = 640;
     const int scoreY = 675;
     const int healthX = 640;
     const int healthY = 10;
 
-    const float sideCollisionChecker = 3.5f;
-    const int scoreIncreaseForSideCollision = 15;
-    const int scoreIncreaseForFrontCollision = 10;
-    const int resetCarTimeDefault = 0;
-
     const int carTimerXPosition = 10;
     const int carTimerYPositions[] = { 10, 50, 90, 130 };
 
-    const float resetCarTimeThreshold1 = 3.0f;
-    const float resetCarTimeThreshold2 = 15.0f;
-    const float sphereMovementSpeedDefault = 2.5f;
-    const float sphereMovementSpeedDecrease = 1.125f;
-
     const int gameOverTextX = 640;
     const int gameOverTextY = 320;
     const int scoreTextX = 640;
@@ -140,19 +275,53 @@ void main() {
     const int restartTextY = 675;
 
     const std::string defaultCarSkin = "white.png";
-    const float defaultCarScaleFactor = 6.0f;
-    const float sphereModelYPosition = 2.5f;
-    const float defaultSphereMovementSpeed = 2.5f;
-    const int defaultCarMovementStatus = true;
-    const int defaultSphereMovementStatus = true;
-    const int defaultCarHitStatus = false;
-    const int defaultResetCarTime = 0;
-    const float positionIncrement = 0.01f;
+    const std::string hitCarSkin = "red.png";
+
+    // Particle budgets, the pools never grow past these so a pile-up cannot stall the frame
+    const int maxSparkParticles = 20000;
+    const int maxDebrisParticles = 5000;
+    const int maxParticleEmitters = 64;
+    const int maxDrawnSparks = 200;
+    const int maxDrawnDebris = 100;
+    const float particleHiddenY = -1000.0f;
+    const float sparkScale = 0.08f;
+    const float debrisScale = 0.1f;
+
+    // Culling of trees and enemies outside the camera view or further away than the cull distance.
+    // The field of view and near clip are TL-Engine's own for the camera, which the game leaves as they are.
+    const float cameraFieldOfView = 60.0f;
+    const float cameraNearClip = 1.0f;
+    const float cullGridCellSize = 10.0f;
+    const float cullGridMargin = 10.0f;
+    const float treeCullHeight = 5.0f;
+    const float treeCullRadius = 6.0f;
+    const float enemyCullHeight = 1.5f;
+    const float enemyCullRadius = 4.0f;
+    const int cullTextX = 10;
+    const int cullTextY = 170;
+
+    const ParticlePoolSettings particlePoolSettings[NUM_PARTICLE_KINDS] = {
+        makeParticlePoolSettings(gameSettings, PARTICLE_SPARK, maxSparkParticles, maxDrawnSparks),
+        makeParticlePoolSettings(gameSettings, PARTICLE_DEBRIS, maxDebrisParticles, maxDrawnDebris)
+    };
+
+    ImpactEmitters impactEmitters = makeImpactEmitters(gameSettings);
+
+    // Gameplay telemetry log, read it back with the TelemetryReader tool
+    const std::string telemetryLogPath = "telemetry.bin";
+
+    // The game simulation, the models below only mirror its state
+    GameWorld world(gameSettings);
+
+    // The game still runs if the log cannot be created, the events just stay in the queue
+    Telemetry telemetry;
+    telemetry.Start(telemetryLogPath);
 
     I3DEngine* myEngine = New3DEngine(kTLX);
     myEngine->StartWindowed();
 
     myEngine->AddMediaFolder("C:\\ProgramData\\TL-Engine\\Media");
+    myEngine->AddMediaFolder("Assessment1Media");
 
     IMesh* groundMesh = myEngine->LoadMesh("ground.x");
     IModel* groundModel = groundMesh->CreateModel();
@@ -163,121 +332,95 @@ void main() {
     IMesh* playerCarMesh = myEngine->LoadMesh("4x4jeep.x");
     IModel* playerCarModel = playerCarMesh->CreateModel();
 
-    ISceneNode* frontLeftWheelNode = playerCarModel->GetNode(4);
-    ISceneNode* frontRightWheelNode = playerCarModel->GetNode(5);
-    ISceneNode* backLeftWheelNode = playerCarModel->GetNode(6);
-    ISceneNode* backRightWheelNode = playerCarModel->GetNode(7);
+    ISceneNode* frontWheelNodes[] = { playerCarModel->GetNode(4), playerCarModel->GetNode(5) };
+    ISceneNode* backWheelNodes[] = { playerCarModel->GetNode(6), playerCarModel->GetNode(7) };
 
     IMesh* enemyStaticCarMesh = myEngine->LoadMesh("audi.x");
     IMesh* enemyMovingCarMesh = myEngine->LoadMesh("estate.x");
     IMesh* ballMesh = myEngine->LoadMesh("ball.x");
 
     EnemyCars staticEnemies[numStaticEnemies];
-    const float enemyStaticCarPositions[numStaticEnemies][3] = {
-        { -20, groundYPosition, 20 },
-        { 20, groundYPosition, 20 },
-        { -20, groundYPosition, 0 },
-        { 20, groundYPosition, 0 }
-    };
 
     for (int i = 0; i < numStaticEnemies; ++i) {
-        staticEnemies[i].enemyCarModel = enemyStaticCarMesh->CreateModel(enemyStaticCarPositions[i][0], enemyStaticCarPositions[i][1], enemyStaticCarPositions[i][2]);
+        const EnemyCar& enemy = world.GetStaticEnemy(i);
+        staticEnemies[i].enemyCarModel = enemyStaticCarMesh->CreateModel(enemy.position.x, enemy.position.y, enemy.position.z);
+        staticEnemies[i].cullState.mesh = enemyStaticCarMesh;
         staticEnemies[i].sphereModel = ballMesh->CreateModel(0, enemySphereYPosition, 0);
         staticEnemies[i].sphereModel->AttachToParent(staticEnemies[i].enemyCarModel);
     }
 
     EnemyCars movingEnemies[numMovingEnemies];
-    const float enemyMovingCarPositions[numMovingEnemies][3] = {
-        { -30, groundYPosition, 15 },
-        { 30, groundYPosition, -15 },
-        { 30, groundYPosition, 30 },
-        { -30, groundYPosition, -30 }
-    };
 
     for (int i = 0; i < numMovingEnemies; ++i) {
-        movingEnemies[i].enemyCarModel = enemyMovingCarMesh->CreateModel(enemyMovingCarPositions[i][0], enemyMovingCarPositions[i][1], enemyMovingCarPositions[i][2]);
-
-        if (i == 0 || i == 3) {
-            movingEnemies[i].enemyCarModel->RotateY(90);
-        }
-        else {
-            movingEnemies[i].enemyCarModel->RotateY(-90);
-        }
+        const EnemyCar& enemy = world.GetMovingEnemy(i);
+        movingEnemies[i].enemyCarModel = enemyMovingCarMesh->CreateModel(enemy.position.x, enemy.position.y, enemy.position.z);
+        movingEnemies[i].enemyCarModel->RotateY(enemy.rotationY);
+        movingEnemies[i].cullState.mesh = enemyMovingCarMesh;
         movingEnemies[i].sphereModel = ballMesh->CreateModel(0, enemySphereYPosition, 0);
         movingEnemies[i].sphereModel->AttachToParent(movingEnemies[i].enemyCarModel);
     }
 
     ICamera* myCamera;
     myCamera = myEngine->CreateCamera(kManual);
-    myCamera->SetPosition(cameraXPosition, cameraYPosition, cameraZPosition);
-    myCamera->RotateLocalX(cameraRotationX);
+    myCamera->SetPosition(gameSettings.cameraDefaultX, gameSettings.cameraDefaultY, gameSettings.cameraDefaultZ);
+    myCamera->RotateLocalX(gameSettings.cameraRotationX);
 
     ISprite* backdrop = myEngine->CreateSprite("backdrop.jpg", backdropWidth, backdropHeight);
     IFont* myFont1 = myEngine->LoadFont("Comic Sans MS", 40);
     IFont* myFont2 = myEngine->LoadFont("Comic Sans MS", 30);
 
     IMesh* treeMesh = myEngine->LoadMesh("tree.x");
-    IModel* perimeterTrees[noOfTrees];
+    const int noOfTrees = int(world.GetTrees().size());
+    std::vector<IModel*> perimeterTrees(noOfTrees);
 
     for (int i = 0; i < noOfTrees; i++) {
-        float angle = (2 * 3.14 / noOfTrees) * i;
-        float treeXPos = perimeterRadius * sin(angle);
-        float treeYPos = perimeterRadius * cos(angle);
-        perimeterTrees[i] = treeMesh->CreateModel(treeXPos, groundYPosition, treeYPos);
+        const Vector3& tree = world.GetTrees()[i];
+        perimeterTrees[i] = treeMesh->CreateModel(tree.x, tree.y, tree.z);
     }
 
+    // Registering every tree and enemy with the culling grid, ids are handed out in the order setCullObjectHidden expects
+    const int numCullObjects = noOfTrees + numStaticEnemies + numMovingEnemies;
+    float cullGridExtent = calculateCullGridExtent(world, gameSettings) + cullGridMargin;
+    CullingGrid cullingGrid(-cullGridExtent, -cullGridExtent, cullGridExtent, cullGridExtent, cullGridCellSize);
+    std::vector<CullState> treeCullStates(noOfTrees);
 
-    myEngine->Timer();
-
-    const BoundingBox enemyMovingCar = { -1.05776, 1.05776, -2.86102e-006, 1.61014, -2.13928, 2.13928 };
-    const BoundingBox enemyStaticCar = { -0.946118, 0.946118, -0.0065695, 1.50131, -1.97237, 1.97237 };
-
-    int score = 0;
-    int playerHealth = 100;
-
-    float dotProduct;
-
-    float prevPosX = 0;
-    float prevPosY = 0;
-    float prevPosZ = 0;
-
-    const float playerCarRadius = 2;
-    const float treeRadius = 1;
-
-    const float maxForwardVelocity = 30.0f;
-    const float maxBackwardVelocity = -30.0f;
-    const float turningVelocity = 100;
-    const float acceleration = 30.0f;
-    const float deceleration = 30.0f;
-    const float minVelocity = 0.0f;
+    for (int i = 0; i < noOfTrees; i++) {
+        treeCullStates[i].cullId = cullingGrid.AddObject({ perimeterTrees[i]->GetX(), treeCullHeight, perimeterTrees[i]->GetZ() }, treeCullRadius);
+        treeCullStates[i].mesh = treeMesh;
+    }
 
-    float forwardVelocity = 0.0f;
-    float backwardVelocity = 0.0f;
-    float rotationAngle = 0.0f;
-    float currentWheelRotation = 0.0f;
+    for (int i = 0; i < numStaticEnemies; i++) {
+        IModel* model = staticEnemies[i].enemyCarModel;
+        staticEnemies[i].cullState.cullId = cullingGrid.AddObject({ model->GetX(), enemyCullHeight, model->GetZ() }, enemyCullRadius);
+    }
 
-    const float bounceFactor = 0.5f;
-    const float scaleFactor = 0.6f;
-    const float decelerationAfterBounce = 5;
+    for (int i = 0; i < numMovingEnemies; i++) {
+        IModel* model = movingEnemies[i].enemyCarModel;
+        movingEnemies[i].cullState.cullId = cullingGrid.AddObject({ model->GetX(), enemyCullHeight, model->GetZ() }, enemyCullRadius);
+    }
 
-    bool moveOppositeCar1 = false;
-    bool moveOppositeCar2 = false;
-    bool moveOppositeSphere = false;
+    ParticleSystem particles(particlePoolSettings, maxParticleEmitters);
 
-    const float movingCarRange = 30.0f;
-    const float sphereMovingMinRange = 2.5;
-    const float sphereMovingMaxRange = 3;
+    // Pools of models reused every frame to draw the nearest particles, parked out of sight when unused
+    IMesh* debrisMesh = myEngine->LoadMesh("cubemesh.x");
+    IModel* sparkModels[maxDrawnSparks];
+    IModel* debrisModels[maxDrawnDebris];
+    int sparkModelsInUse = 0;
+    int debrisModelsInUse = 0;
 
-    float resetCarTimes[numMovingEnemies] = { 0, 0, 0, 0 };
+    for (int i = 0; i < maxDrawnSparks; i++) {
+        sparkModels[i] = ballMesh->CreateModel(0, particleHiddenY, 0);
+        sparkModels[i]->Scale(sparkScale);
+        sparkModels[i]->SetSkin("red.png");
+    }
 
-    bool allStaticCarsHit = false;
-    bool allMovingCarsHit = false;
+    for (int i = 0; i < maxDrawnDebris; i++) {
+        debrisModels[i] = debrisMesh->CreateModel(0, particleHiddenY, 0);
+        debrisModels[i]->Scale(debrisScale);
+    }
 
-    bool win = false;
 
-    const float maxWheelRotation = 30.0f;
-    bool turningLeft = false;
-    bool turningRight = false;
+    myEngine->Timer();
 
     const int gamePausedTextX = 640;
     const int gamePausedTextY = 320;
@@ -298,14 +441,28 @@ void main() {
 
         float frameTime = myEngine->Timer();
 
+#ifndef GAME_TUNING_BAKED
+        // Picking up tuning changes between frames, so a whole step always runs with the same values
+        if (tuningWatcher.TakeSettings(gameSettings)) {
+            world.SetSettings(gameSettings);
+            particles.GetPool(PARTICLE_SPARK).SetSettings(makeParticlePoolSettings(gameSettings, PARTICLE_SPARK, maxSparkParticles, maxDrawnSparks));
+            particles.GetPool(PARTICLE_DEBRIS).SetSettings(makeParticlePoolSettings(gameSettings, PARTICLE_DEBRIS, maxDebrisParticles, maxDrawnDebris));
+            impactEmitters = makeImpactEmitters(gameSettings);
+
+            // The moving enemies' road can get longer, so the culling grid is stretched to cover it
+            float newCullGridExtent = calculateCullGridExtent(world, gameSettings) + cullGridMargin;
+            if (newCullGridExtent != cullGridExtent) {
+                cullGridExtent = newCullGridExtent;
+                cullingGrid.SetBounds(-cullGridExtent, -cullGridExtent, cullGridExtent, cullGridExtent);
+            }
+        }
+        tuningWatcher.TakeErrors(tuningErrors);
+#endif
+
         if (myEngine->KeyHit(Key_Escape)) {
             myEngine->Stop();
         }
 
-        prevPosX = playerCarModel->GetX();
-        prevPosY = playerCarModel->GetY();
-        prevPosZ = playerCarModel->GetZ();
-
         // Handling game controls and logic based on the current game state
         switch (gameState) {
 
@@ -313,398 +470,119 @@ void main() {
 
             if (myEngine->KeyHit(Key_1)) {
                 myCamera->DetachFromParent();
-                myCamera->SetPosition(cameraDefaultX, cameraDefaultY, cameraDefaultZ);
+                myCamera->SetPosition(gameSettings.cameraDefaultX, gameSettings.cameraDefaultY, gameSettings.cameraDefaultZ);
             }
 
             if (myEngine->KeyHit(Key_2)) {
                 myCamera->AttachToParent(playerCarModel);
-                myCamera->SetLocalPosition(cameraAttachedX, cameraAttachedY1, cameraAttachedZ);
+                myCamera->SetLocalPosition(gameSettings.cameraAttachedX, gameSettings.cameraAttachedY1, gameSettings.cameraAttachedZ);
             }
 
             if (myEngine->KeyHit(Key_3)) {
                 myCamera->AttachToParent(playerCarModel);
-                myCamera->SetLocalPosition(cameraAttachedX, cameraAttachedY2, cameraAttachedX);
+                myCamera->SetLocalPosition(gameSettings.cameraAttachedX, gameSettings.cameraAttachedY2, gameSettings.cameraBonnetZ);
             }
 
-            myFont1->Draw("Score: " + std::to_string(score), scoreX, scoreY, kBlue, kCentre);
-            myFont1->Draw("Health: " + std::to_string(playerHealth), healthX, healthY, kGreen, kCentre);
+            myFont1->Draw("Score: " + std::to_string(world.GetScore()), scoreX, scoreY, kBlue, kCentre);
+            myFont1->Draw("Health: " + std::to_string(world.GetPlayerHealth()), healthX, healthY, kGreen, kCentre);
 
             if (myEngine->KeyHit(Key_P)) {
                 gameState = GAME_PAUSED;
             }
 
-            if (myEngine->KeyHeld(Key_W))
+            // Running the game simulation for this frame and copying the result onto the models
             {
-                if (forwardVelocity < maxForwardVelocity)
-                {
-                    forwardVelocity += acceleration * frameTime;
-                }
-
-                if (myEngine->KeyHeld(Key_D) && !myEngine->KeyHeld(Key_A))
-                {
-                    playerCarModel->RotateY(turningVelocity * frameTime);
-                    turningRight = true;
-                    turningLeft = false;
-                }
-                else if (myEngine->KeyHeld(Key_A) && !myEngine->KeyHeld(Key_D))
-                {
-                    playerCarModel->RotateY(-turningVelocity * frameTime);
-                    turningLeft = true;
-                    turningRight = false;
-                }
-                else
-                {
-                    turningLeft = false;
-                    turningRight = false;
-                }
+                DriveInput input = { myEngine->KeyHeld(Key_W), myEngine->KeyHeld(Key_S),
+                                     myEngine->KeyHeld(Key_A), myEngine->KeyHeld(Key_D) };
+                world.Step(input, frameTime);
             }
-            else
-            {
-                if (forwardVelocity > minVelocity)
-                {
-                    forwardVelocity -= deceleration * frameTime;
-                }
 
-            }
+            syncPlayerModel(world, playerCarModel, frontWheelNodes, backWheelNodes);
+            syncEnemyModels(world, staticEnemies, movingEnemies);
 
-            if (myEngine->KeyHeld(Key_S))
-            {
-                if (backwardVelocity > maxBackwardVelocity)
-                {
-                    backwardVelocity -= acceleration * frameTime;
-                }
+            // Showing feedback for the hits that happened this frame and recording them
+            for (const GameEvent& event : world.GetEvents()) {
+                telemetry.Emit(makeTelemetryEvent(event, gameSettings.sideCollisionChecker));
 
-                if (myEngine->KeyHeld(Key_D) && !myEngine->KeyHeld(Key_A))
-                {
-                    playerCarModel->RotateY(-turningVelocity * frameTime);
-                    turningRight = true;
-                    turningLeft = false;
-                }
-                else if (myEngine->KeyHeld(Key_A) && !myEngine->KeyHeld(Key_D))
-                {
-                    playerCarModel->RotateY(turningVelocity * frameTime);
-                    turningLeft = true;
-                    turningRight = false;
-                }
-                else
-                {
-                    turningLeft = false;
-                    turningRight = false;
-                }
-            }
-            else
-            {
-                if (backwardVelocity < minVelocity)
-                {
-                    backwardVelocity += deceleration * frameTime;
-                }
-
-            }
-
-            if (myEngine->KeyHeld(Key_D) && !myEngine->KeyHeld(Key_A))
-            {
-                turningRight = true;
-                turningLeft = false;
-            }
-            else if (myEngine->KeyHeld(Key_A) && !myEngine->KeyHeld(Key_D))
-            {
-                turningLeft = true;
-                turningRight = false;
-            }
-            else
-            {
-                turningLeft = false;
-                turningRight = false;
-            }
-
-            rotationAngle = (forwardVelocity + backwardVelocity) * frameTime * turningVelocity;
-
-            backLeftWheelNode->RotateLocalX(rotationAngle);
-            backRightWheelNode->RotateLocalX(rotationAngle);
-            frontLeftWheelNode->RotateLocalX(rotationAngle);
-            frontRightWheelNode->RotateLocalX(rotationAngle);
-
-            playerCarModel->MoveLocalZ((forwardVelocity + backwardVelocity) * frameTime);
-
-            if (forwardVelocity < minVelocity) {
-                forwardVelocity += decelerationAfterBounce * frameTime;
-            }
-            if (backwardVelocity > minVelocity) {
-                backwardVelocity -= decelerationAfterBounce * frameTime;
-            }
+                Vector3 impactPoint = { event.impactPoint.x, gameSettings.impactHeight, event.impactPoint.z };
 
+                switch (event.type) {
+                case EVENT_TREE_HIT:
+                    spawnImpactParticles(particles, impactPoint, impactEmitters.treeSparks, &impactEmitters.treeDebris);
+                    break;
 
-            if (turningLeft || turningRight)
-            {
-                if (currentWheelRotation > -maxWheelRotation && currentWheelRotation < maxWheelRotation)
-                {
-                    float rotationAmount = (turningLeft ? -maxWheelRotation : maxWheelRotation);
+                case EVENT_STATIC_CAR_HIT:
+                    spawnImpactParticles(particles, impactPoint, impactEmitters.carSparks,
+                                         event.scoreChange != 0 ? &impactEmitters.carDebris : nullptr);
+                    setSphereSkin(staticEnemies[event.index], hitCarSkin);
 
-                    frontLeftWheelNode->RotateY(rotationAmount);
-                    frontRightWheelNode->RotateY(rotationAmount);
-                    currentWheelRotation = rotationAmount;
-                }
-            }
-            else
-            {
-                frontLeftWheelNode->RotateY(-currentWheelRotation);
-                frontRightWheelNode->RotateY(-currentWheelRotation);
-                currentWheelRotation = minVelocity;
-            }
-
-            for (int i = 0; i < noOfTrees; i++) {
-                Vector3 carToTreeVector = { playerCarModel->GetX() - perimeterTrees[i]->GetX(),
-                                            playerCarModel->GetY() - perimeterTrees[i]->GetY(),
-                                            playerCarModel->GetZ() - perimeterTrees[i]->GetZ() };
-
-                float distance = calculateModulus(carToTreeVector);
-
-                if (distance <= playerCarRadius + treeRadius) {
-
-                    float relativeVelocity = forwardVelocity + backwardVelocity;
-
-                    if (relativeVelocity > minVelocity) {
-                        forwardVelocity = -relativeVelocity * bounceFactor;
-                        backwardVelocity = minVelocity;
+                    // Squashing the car along the side it was hit from
+                    if (event.scoreChange != 0) {
+                        EnemyCars& hitCar = staticEnemies[event.index];
+                        int axis = world.GetStaticEnemy(event.index).carSideHit ? 0 : 2;
+                        hitCar.squashScale = gameSettings.scaleFactor;
+                        scaleModelAxis(hitCar.enemyCarModel, hitCar.cullState, axis, hitCar.squashScale);
                     }
+                    break;
 
-                    if (relativeVelocity < minVelocity) {
-                        backwardVelocity = -relativeVelocity * bounceFactor;
-                        forwardVelocity = minVelocity;
-                    }
-
-                    playerHealth -= 1;
+                case EVENT_MOVING_CAR_HIT:
+                    spawnImpactParticles(particles, impactPoint, impactEmitters.carSparks,
+                                         event.scoreChange != 0 ? &impactEmitters.carDebris : nullptr);
+                    setSphereSkin(movingEnemies[event.index], hitCarSkin);
+                    break;
 
-                    playerCarModel->SetPosition(prevPosX, prevPosY, prevPosZ);
+                case EVENT_MOVING_CAR_RESET:
+                    setSphereSkin(movingEnemies[event.index], defaultCarSkin);
+                    break;
                 }
             }
 
-            myFont2->Draw("Car1 Timer: " + std::to_string(resetCarTimes[0]) + " seconds", carTimerXPosition, carTimerYPositions[0], kBlack, kLeft, kTop);
-            myFont2->Draw("Car2 Timer: " + std::to_string(resetCarTimes[1]) + " seconds", carTimerXPosition, carTimerYPositions[1], kBlack, kLeft, kTop);
-            myFont2->Draw("Car3 Timer: " + std::to_string(resetCarTimes[2]) + " seconds", carTimerXPosition, carTimerYPositions[2], kBlack, kLeft, kTop);
-            myFont2->Draw("Car4 Timer: " + std::to_string(resetCarTimes[3]) + " seconds", carTimerXPosition, carTimerYPositions[3], kBlack, kLeft, kTop);
-
-            for (int i = 0; i < numStaticEnemies; i++) {
-                if (CheckCollision(playerCarModel, staticEnemies[i].enemyCarModel, playerCarRadius, enemyStaticCar)) {
-
-                    Vector3 playerFacingVector;
-                    calculateFacingVector(playerCarModel, playerFacingVector);
-
-                    Vector3 enemyCarToJeepVector;
-                    calculateEnemyCarToJeepVector(staticEnemies[i].enemyCarModel, playerCarModel, enemyCarToJeepVector);
-
-                    dotProduct = calculateDotProduct(playerFacingVector, enemyCarToJeepVector);
-
-                    if (staticEnemies[i].carHitStatus == false) {
-                        if (dotProduct > -sideCollisionChecker) {
-                            score += scoreIncreaseForFrontCollision;
-                            staticEnemies[i].carSideHit = true;
-                            float matrix[4][4];
-                            staticEnemies[i].enemyCarModel->GetMatrix(&matrix[0][0]);
-                            matrix[0][0] *= scaleFactor;
-                            matrix[0][1] *= scaleFactor;
-                            matrix[0][2] *= scaleFactor;
-                            staticEnemies[i].enemyCarModel->SetMatrix(&matrix[0][0]);
-                            staticEnemies[i].carHitStatus = true;
-                        }
-                        else if (dotProduct < -sideCollisionChecker) {
-                            score += scoreIncreaseForSideCollision;
-                            staticEnemies[i].carSideHit = false;
-                            float matrix[4][4];
-                            staticEnemies[i].enemyCarModel->GetMatrix(&matrix[0][0]);
-                            matrix[2][0] *= scaleFactor;
-                            matrix[2][1] *= scaleFactor;
-                            matrix[2][2] *= scaleFactor;
-                            staticEnemies[i].enemyCarModel->SetMatrix(&matrix[0][0]);
-                            staticEnemies[i].carHitStatus = true;
-                        }
-                    }
-
-
-                    float relativeVelocity = forwardVelocity + backwardVelocity;
-
-                    if (relativeVelocity > minVelocity) {
-                        forwardVelocity = -relativeVelocity * bounceFactor;
-                        backwardVelocity = minVelocity;
-
-
-                    }
-
-                    if (relativeVelocity < minVelocity) {
-                        backwardVelocity = -relativeVelocity * bounceFactor;
-                        forwardVelocity = minVelocity;
-                    }
+            for (int i = 0; i < numMovingEnemies; i++) {
+                myFont2->Draw("Car" + std::to_string(i + 1) + " Timer: " + std::to_string(world.GetMovingEnemy(i).resetCarTime) + " seconds",
+                              carTimerXPosition, carTimerYPositions[i], kBlack, kLeft, kTop);
+            }
 
-                    playerCarModel->SetPosition(prevPosX, prevPosY, prevPosZ);
-                    staticEnemies[i].sphereModel->SetSkin("red.png");
-                }
+            // Updating the particles and handing the nearest ones to the pooled models for drawing
+            particles.Update(frameTime);
+            {
+                Vector3 cameraPosition = { myCamera->GetX(), myCamera->GetY(), myCamera->GetZ() };
+                const ParticleDrawBatch* particleBatches = particles.BuildDrawBatches(cameraPosition);
+                drawParticleBatch(particleBatches[PARTICLE_SPARK], sparkModels, sparkModelsInUse, particleHiddenY);
+                drawParticleBatch(particleBatches[PARTICLE_DEBRIS], debrisModels, debrisModelsInUse, particleHiddenY);
             }
 
+            // Culling trees and enemies the camera cannot see, models are only touched when their visibility changes
             for (int i = 0; i < numMovingEnemies; i++) {
-                if (movingEnemies[i].carMovementStatus == true) {
-                    if (i == 0 || i == 3) {
-                        if (moveOppositeCar1 == false) {
-                            if (movingEnemies[i].enemyCarModel->GetX() <= movingCarRange) {
-                                movingEnemies[i].enemyCarModel->MoveX(movingEnemies[i].carMovementSpeed * frameTime);
-                            }
-                            else {
-                                moveOppositeCar1 = true;
-                            }
-                        }
-                        else {
-                            if (movingEnemies[i].enemyCarModel->GetX() >= -movingCarRange) {
-                                movingEnemies[i].enemyCarModel->MoveX(-movingEnemies[i].carMovementSpeed * frameTime);
-
-                            }
-                            else {
-                                moveOppositeCar1 = false;
-                            }
-                        }
-                    }
-                    else {
-                        if (moveOppositeCar2 == false) {
-                            if (movingEnemies[i].enemyCarModel->GetX() <= movingCarRange) {
-                                movingEnemies[i].enemyCarModel->MoveX(movingEnemies[i].carMovementSpeed * frameTime);
-
-                            }
-                            else {
-                                moveOppositeCar2 = true;
-                            }
-                        }
-                        else {
-                            if (movingEnemies[i].enemyCarModel->GetX() >= -movingCarRange) {
-                                movingEnemies[i].enemyCarModel->MoveX(-movingEnemies[i].carMovementSpeed * frameTime);
-
-                            }
-                            else {
-                                moveOppositeCar2 = false;
-                            }
-                        }
-                    }
-                }
-
-                if (CheckCollision(playerCarModel, movingEnemies[i].enemyCarModel, playerCarRadius, enemyMovingCar)) {
-
-                    Vector3 playerFacingVector;
-                    calculateFacingVector(playerCarModel, playerFacingVector);
-
-                    Vector3 enemyCarToJeepVector;
-                    calculateEnemyCarToJeepVector(movingEnemies[i].enemyCarModel, playerCarModel, enemyCarToJeepVector);
-
-                    dotProduct = calculateDotProduct(playerFacingVector, enemyCarToJeepVector);
-
-                    if (movingEnemies[i].carHitStatus == false) {
-                        if (dotProduct < -sideCollisionChecker) {
-                            score += scoreIncreaseForSideCollision;
-                            movingEnemies[i].carHitStatus = true;
-                            movingEnemies[i].carMovementStatus = false;
-                            resetCarTimes[i] = resetCarTimeDefault;
-                        }
-                        else if (dotProduct > -sideCollisionChecker) {
-                            score += scoreIncreaseForFrontCollision;
-                            movingEnemies[i].carHitStatus = true;
-                            movingEnemies[i].carMovementStatus = false;
-                            resetCarTimes[i] = resetCarTimeDefault;
-                        }
-                    }
-
-                    float relativeVelocity = forwardVelocity + backwardVelocity;
-
-                    if (relativeVelocity > minVelocity) {
-                        forwardVelocity = -relativeVelocity * bounceFactor;
-                        backwardVelocity = minVelocity;
-
-
-                    }
-
-                    if (relativeVelocity < minVelocity) {
-                        backwardVelocity = -relativeVelocity * bounceFactor;
-                        forwardVelocity = minVelocity;
-                    }
-
-                    if (prevPosX < 0) {
-                        prevPosX -= positionIncrement;
-                    }
-                    else {
-                        prevPosX += positionIncrement;
-                    }
-
-                    if (prevPosZ < 0) {
-                        prevPosZ -= positionIncrement;
-                    }
-                    else {
-                        prevPosZ += positionIncrement;
-                    }
-
-                    playerCarModel->SetPosition(prevPosX, prevPosY, prevPosZ);
-
-
-                    movingEnemies[i].sphereModel->SetSkin("red.png");
-                }
-
-                if (movingEnemies[i].sphereMovementStatus == true) {
-
-                    if (moveOppositeSphere == false) {
-                        if (movingEnemies[i].sphereModel->GetY() <= sphereMovingMaxRange) {
-                            movingEnemies[i].sphereModel->MoveY(movingEnemies[i].sphereMovementSpeed * frameTime);
-                        }
-                        else {
-                            moveOppositeSphere = true;
-                        }
-                    }
-                    else {
-                        if (movingEnemies[i].sphereModel->GetY() >= sphereMovingMinRange) {
-                            movingEnemies[i].sphereModel->MoveY(-movingEnemies[i].sphereMovementSpeed * frameTime);
-                        }
-                        else {
-                            moveOppositeSphere = false;
-                        }
-                    }
+                const EnemyCar& enemy = world.GetMovingEnemy(i);
+                cullingGrid.MoveObject(movingEnemies[i].cullState.cullId, { enemy.position.x, enemyCullHeight, enemy.position.z });
+            }
+            {
+                float cameraMatrix[4][4];
+                myCamera->GetMatrix(&cameraMatrix[0][0]);
+                float aspectRatio = float(myEngine->GetWidth()) / float(myEngine->GetHeight());
+                Frustum frustum = calculateFrustum(cameraMatrix, cameraFieldOfView, aspectRatio, cameraNearClip, gameSettings.cullDistance);
+                Vector3 cameraPosition = { cameraMatrix[3][0], cameraMatrix[3][1], cameraMatrix[3][2] };
+                cullingGrid.Update(frustum, cameraPosition, gameSettings.cullDistance);
+
+                for (int id : cullingGrid.GetHiddenObjects()) {
+                    setCullObjectHidden(id, true, perimeterTrees, treeCullStates, staticEnemies, movingEnemies, ballMesh, world);
                 }
-
-                if (movingEnemies[i].carMovementStatus == false) {
-                    resetCarTimes[i] += frameTime;
-                    movingEnemies[i].sphereMovementSpeed -= sphereMovementSpeedDecrease * frameTime;
-
-                    if (resetCarTimes[i] >= resetCarTimeThreshold1) {
-                        movingEnemies[i].sphereMovementStatus = false;
-                        movingEnemies[i].sphereMovementSpeed = sphereMovementSpeedDefault;
-                    }
-
-                    if (resetCarTimes[i] >= resetCarTimeThreshold2) {
-                        movingEnemies[i].carMovementStatus = true;
-                        movingEnemies[i].sphereMovementStatus = true;
-                        movingEnemies[i].carHitStatus = false;
-                        movingEnemies[i].sphereModel->SetSkin("white.png");
-
-                        if (dotProduct < -sideCollisionChecker) {
-                            score -= scoreIncreaseForSideCollision;
-                        }
-                        else if (dotProduct > -sideCollisionChecker) {
-                            score -= scoreIncreaseForFrontCollision;
-                        }
-                    }
+                for (int id : cullingGrid.GetShownObjects()) {
+                    setCullObjectHidden(id, false, perimeterTrees, treeCullStates, staticEnemies, movingEnemies, ballMesh, world);
                 }
             }
+            myFont2->Draw("Culled: " + std::to_string(cullingGrid.GetCulledCount()) + " / " + std::to_string(numCullObjects), cullTextX, cullTextY, kBlack, kLeft, kTop);
 
-            if (movingEnemies[0].carMovementStatus == false &&
-                movingEnemies[1].carMovementStatus == false &&
-                movingEnemies[2].carMovementStatus == false &&
-                movingEnemies[3].carMovementStatus == false) {
-
-                allMovingCarsHit = true;
-            }
-
-            if (staticEnemies[0].carHitStatus == true &&
-                staticEnemies[1].carHitStatus == true &&
-                staticEnemies[2].carHitStatus == true &&
-                staticEnemies[3].carHitStatus == true) {
-
-                allStaticCarsHit = true;
+#ifndef GAME_TUNING_BAKED
+            // Showing why an edit to tuning.cfg was not used, the game keeps its last good values meanwhile
+            if (!tuningErrors.empty()) {
+                myFont2->Draw("Tuning: " + tuningErrors.substr(0, tuningErrors.find('\n')), tuningTextX, tuningTextY, kRed, kLeft, kTop);
             }
+#endif
 
             // Checking win condition
-            if ((allStaticCarsHit == true && allMovingCarsHit == true) || playerHealth < 1) {
+            if (world.IsGameOver()) {
+                telemetry.Emit(makeTelemetryEvent(TELEMETRY_GAME_OVER, world));
                 gameState = GAME_OVER;
             }
 
@@ -713,8 +591,8 @@ void main() {
         case GAME_PAUSED:
 
             myFont1->Draw("Game Paused", gamePausedTextX, gamePausedTextY, kRed, kCentre);
-            myFont1->Draw("Score: " + std::to_string(score), scoreTextX, scoreTextY, kBlue, kCentre);
-            myFont1->Draw("Health: " + std::to_string(playerHealth), healthTextX, healthTextY, kGreen, kCentre);
+            myFont1->Draw("Score: " + std::to_string(world.GetScore()), scoreTextX, scoreTextY, kBlue, kCentre);
+            myFont1->Draw("Health: " + std::to_string(world.GetPlayerHealth()), healthTextX, healthTextY, kGreen, kCentre);
 
             if (myEngine->KeyHit(Key_P)) {
                 gameState = GAME_PLAYING;
@@ -724,69 +602,35 @@ void main() {
 
         case GAME_OVER:
 
-            std::string outcome = (allStaticCarsHit == true && allMovingCarsHit == true) ? "You Win!" : "You Lose!";
+            std::string outcome = world.HasWon() ? "You Win!" : "You Lose!";
             myFont1->Draw(outcome, gameOverTextX, gameOverTextY, kRed, kCentre);
-            myFont1->Draw("Score = " + std::to_string(score), scoreTextX, scoreTextY, kRed, kCentre);
+            myFont1->Draw("Score = " + std::to_string(world.GetScore()), scoreTextX, scoreTextY, kRed, kCentre);
             myFont1->Draw("Tap R to Restart / Tap Esc to Quit", restartTextX, restartTextY, kBlue, kCentre);
 
             if (myEngine->KeyHit(Key_R)) {
                 myCamera->DetachFromParent();
-                myCamera->SetPosition(cameraDefaultX, cameraDefaultY, cameraDefaultZ);
-
-                score = 0;
-                playerHealth = 100;
-
-                prevPosX = 0;
-                prevPosY = 0;
-                prevPosZ = 0;
-
-                forwardVelocity = 0.0f;
-                backwardVelocity = 0.0f;
-
-                moveOppositeCar1 = false;
-                moveOppositeCar2 = false;
-                moveOppositeSphere = false;
-
-                allStaticCarsHit = false;
-                allMovingCarsHit = false;
-
-                playerCarModel->SetPosition(0, 0, 0);
-                playerCarModel->ResetOrientation();
+                myCamera->SetPosition(gameSettings.cameraDefaultX, gameSettings.cameraDefaultY, gameSettings.cameraDefaultZ);
 
+                // Undoing the squash on the cars that were hit before the world forgets which ones they were
                 for (int i = 0; i < numStaticEnemies; ++i) {
-                    staticEnemies[i].enemyCarModel->SetPosition(enemyStaticCarPositions[i][0], enemyStaticCarPositions[i][1], enemyStaticCarPositions[i][2]);
-                    staticEnemies[i].sphereModel->SetSkin(defaultCarSkin);
-
-                    if (staticEnemies[i].carSideHit == true && staticEnemies[i].carHitStatus == true) {
-                        float matrix[4][4];
-                        staticEnemies[i].enemyCarModel->GetMatrix(&matrix[0][0]);
-                        matrix[0][0] /= scaleFactor;
-                        matrix[0][1] /= scaleFactor;
-                        matrix[0][2] /= scaleFactor;
-                        staticEnemies[i].enemyCarModel->SetMatrix(&matrix[0][0]);
+                    const EnemyCar& enemy = world.GetStaticEnemy(i);
+                    if (enemy.carHitStatus == true) {
+                        int axis = enemy.carSideHit ? 0 : 2;
+                        scaleModelAxis(staticEnemies[i].enemyCarModel, staticEnemies[i].cullState, axis, 1.0f / staticEnemies[i].squashScale);
                     }
-
-                    if (staticEnemies[i].carSideHit == false && staticEnemies[i].carHitStatus == true) {
-                        float matrix[4][4];
-                        staticEnemies[i].enemyCarModel->GetMatrix(&matrix[0][0]);
-                        matrix[2][0] /= scaleFactor;
-                        matrix[2][1] /= scaleFactor;
-                        matrix[2][2] /= scaleFactor;
-                        staticEnemies[i].enemyCarModel->SetMatrix(&matrix[0][0]);
-                    }
-                    staticEnemies[i].carHitStatus = false;
-
-                    movingEnemies[i].enemyCarModel->SetPosition(enemyMovingCarPositions[i][0], enemyMovingCarPositions[i][1], enemyMovingCarPositions[i][2]);
-                    movingEnemies[i].sphereModel->SetSkin(defaultCarSkin);
-                    movingEnemies[i].sphereModel->SetLocalPosition(0, sphereModelYPosition, 0);
-                    movingEnemies[i].sphereMovementSpeed = defaultSphereMovementSpeed;
-                    movingEnemies[i].carHitStatus = false;
-                    movingEnemies[i].carMovementStatus = true;
-                    movingEnemies[i].sphereMovementStatus = true;
-
-                    resetCarTimes[i] = 0;
+                    staticEnemies[i].squashScale = 1.0f;
+                    setSphereSkin(staticEnemies[i], defaultCarSkin);
+                    setSphereSkin(movingEnemies[i], defaultCarSkin);
                 }
 
+                world.Restart();
+                telemetry.Emit(makeTelemetryEvent(TELEMETRY_GAME_RESTART, world));
+                syncPlayerModel(world, playerCarModel, frontWheelNodes, backWheelNodes);
+                syncEnemyModels(world, staticEnemies, movingEnemies);
+
+                particles.Clear();
+                drawParticleBatch({ PARTICLE_SPARK, nullptr, 0 }, sparkModels, sparkModelsInUse, particleHiddenY);
+                drawParticleBatch({ PARTICLE_DEBRIS, nullptr, 0 }, debrisModels, debrisModelsInUse, particleHiddenY);
 
                 gameState = GAME_PLAYING;
             }
@@ -794,5 +638,9 @@ void main() {
             break;
         }
     }
+    telemetry.Stop();
+#ifndef GAME_TUNING_BAKED
+    tuningWatcher.Stop();
+#endif
     myEngine->Delete();
 }
@@ -0,0 +1,251 @@
+# Runs the benchmark suite and compares the median CPU time of every benchmark against the stored baseline.
+#
+#   cmake -DBENCHMARK=<exe> -DBASELINE=<json> -DRESULTS=<json> -DTHRESHOLD=0.25 [-DUPDATE=ON] [-DEXCLUDED=<names>]
+#         -P CompareBaseline.cmake
+#
+# A benchmark more than THRESHOLD (a fraction, 0.25 = 25%) slower than its baseline fails the run, and so does
+# a benchmark that reports an error or a baseline entry that did not run. EXCLUDED is a comma separated list of
+# baseline entries this build leaves out on purpose, such as BM_TreeScan in baked tuning builds.
+# With UPDATE=ON the baseline is rewritten from this run instead.
+#
+# The baseline can also give benchmarks an absolute budget in its "budgets" section, in the same unit. Those
+# are limits the game has to meet on any machine, so they fail the run whatever the baseline says, and
+# UPDATE=ON keeps them as they are.
+
+cmake_minimum_required(VERSION 3.19)
+
+foreach(variable BENCHMARK BASELINE RESULTS THRESHOLD)
+    if(NOT DEFINED ${variable})
+        message(FATAL_ERROR "CompareBaseline.cmake needs -D${variable}=...")
+    endif()
+endforeach()
+
+if(NOT DEFINED REPETITIONS)
+    set(REPETITIONS 5)
+endif()
+if(NOT DEFINED MIN_TIME)
+    set(MIN_TIME 0.1)
+endif()
+
+# Commas keep the list in one argument when it is passed through add_test
+string(REPLACE "," ";" EXCLUDED "${EXCLUDED}")
+
+execute_process(
+    COMMAND "${BENCHMARK}"
+        --benchmark_repetitions=${REPETITIONS}
+        --benchmark_report_aggregates_only=true
+        --benchmark_min_time=${MIN_TIME}
+        --benchmark_out=${RESULTS}
+        --benchmark_out_format=json
+    RESULT_VARIABLE benchmarkResult)
+if(NOT benchmarkResult EQUAL 0)
+    message(FATAL_ERROR "Benchmark run failed: ${benchmarkResult}")
+endif()
+
+# Convert a time in the given google benchmark unit to picoseconds
+function(to_picoseconds time unit outVariable)
+    if(unit STREQUAL "us")
+        math(EXPR scale "1000")
+    elseif(unit STREQUAL "ms")
+        math(EXPR scale "1000000")
+    elseif(unit STREQUAL "s")
+        math(EXPR scale "1000000000")
+    else()
+        set(scale 1)
+    endif()
+    # CMake maths is integer only, so keep three decimal places by working in picoseconds
+    string(REGEX REPLACE "e.*$" "" mantissa "${time}")
+    string(REGEX MATCH "e([-+]?[0-9]+)$" exponentMatch "${time}")
+    set(exponent 0)
+    if(exponentMatch)
+        set(exponent ${CMAKE_MATCH_1})
+    endif()
+    string(REGEX MATCH "^([0-9]+)(\\.([0-9]*))?$" _ "${mantissa}")
+    set(whole ${CMAKE_MATCH_1})
+    set(fraction "${CMAKE_MATCH_3}000")
+    string(SUBSTRING "${fraction}" 0 3 fraction)
+    string(REGEX REPLACE "^0+" "" fraction "${fraction}")
+    if(fraction STREQUAL "")
+        set(fraction 0)
+    endif()
+    math(EXPR picoseconds "(${whole} * 1000 + ${fraction}) * ${scale}")
+    while(exponent GREATER 0)
+        math(EXPR picoseconds "${picoseconds} * 10")
+        math(EXPR exponent "${exponent} - 1")
+    endwhile()
+    while(exponent LESS 0)
+        math(EXPR picoseconds "${picoseconds} / 10")
+        math(EXPR exponent "${exponent} + 1")
+    endwhile()
+    set(${outVariable} ${picoseconds} PARENT_SCOPE)
+endfunction()
+
+# Collect the median CPU time of each benchmark in picoseconds, keyed by run name
+file(READ "${RESULTS}" resultsJson)
+string(JSON resultCount LENGTH "${resultsJson}" benchmarks)
+set(names "")
+set(failedNames "")
+math(EXPR lastResult "${resultCount} - 1")
+foreach(index RANGE ${lastResult})
+    # A single repetition only reports plain iterations, otherwise only the median is used
+    string(JSON runType GET "${resultsJson}" benchmarks ${index} run_type)
+    if(runType STREQUAL "aggregate")
+        string(JSON aggregate GET "${resultsJson}" benchmarks ${index} aggregate_name)
+        if(NOT aggregate STREQUAL "median")
+            continue()
+        endif()
+    endif()
+    string(JSON name GET "${resultsJson}" benchmarks ${index} run_name)
+
+    # A run stopped by SkipWithError still reports a time of 0, which would always pass
+    string(JSON errorOccurred ERROR_VARIABLE noError GET "${resultsJson}" benchmarks ${index} error_occurred)
+    if(NOT noError AND errorOccurred)
+        string(JSON errorMessage ERROR_VARIABLE noMessage GET "${resultsJson}" benchmarks ${index} error_message)
+        message(STATUS "ERROR      ${name}: ${errorMessage}")
+        list(APPEND failedNames "${name}")
+        continue()
+    endif()
+
+    string(JSON cpuTime GET "${resultsJson}" benchmarks ${index} cpu_time)
+    string(JSON unit GET "${resultsJson}" benchmarks ${index} time_unit)
+    to_picoseconds("${cpuTime}" "${unit}" picoseconds)
+    list(APPEND names "${name}")
+    set("current_${name}" ${picoseconds})
+endforeach()
+
+if(failedNames)
+    list(LENGTH failedNames failedCount)
+    message(FATAL_ERROR "${failedCount} benchmark(s) reported an error")
+endif()
+if(NOT names)
+    message(FATAL_ERROR "No benchmark results found in ${RESULTS}")
+endif()
+
+# Read the names and times of the absolute budgets in the baseline, if it has any
+function(read_budgets json namesVariable)
+    set(budgetNames "")
+    string(JSON budgetCount ERROR_VARIABLE noBudgets LENGTH "${json}" budgets)
+    if(NOT noBudgets AND budgetCount GREATER 0)
+        math(EXPR lastBudget "${budgetCount} - 1")
+        foreach(index RANGE ${lastBudget})
+            string(JSON name MEMBER "${json}" budgets ${index})
+            string(JSON budget GET "${json}" budgets "${name}")
+            list(APPEND budgetNames "${name}")
+            set("budget_${name}" ${budget} PARENT_SCOPE)
+        endforeach()
+    endif()
+    set(${namesVariable} "${budgetNames}" PARENT_SCOPE)
+endfunction()
+
+if(UPDATE)
+    set(budgetNames "")
+    if(EXISTS "${BASELINE}")
+        file(READ "${BASELINE}" oldBaselineJson)
+        read_budgets("${oldBaselineJson}" budgetNames)
+    endif()
+
+    set(baselineJson "{\n  \"time_unit\": \"ps\",\n  \"benchmarks\": {")
+    set(separator "")
+    foreach(name IN LISTS names)
+        string(APPEND baselineJson "${separator}\n    \"${name}\": ${current_${name}}")
+        set(separator ",")
+    endforeach()
+    string(APPEND baselineJson "\n  }")
+    if(budgetNames)
+        string(APPEND baselineJson ",\n  \"budgets\": {")
+        set(separator "")
+        foreach(name IN LISTS budgetNames)
+            string(APPEND baselineJson "${separator}\n    \"${name}\": ${budget_${name}}")
+            set(separator ",")
+        endforeach()
+        string(APPEND baselineJson "\n  }")
+    endif()
+    string(APPEND baselineJson "\n}\n")
+    file(WRITE "${BASELINE}" "${baselineJson}")
+    message(STATUS "Benchmark baseline written to ${BASELINE}")
+    return()
+endif()
+
+if(NOT EXISTS "${BASELINE}")
+    message(FATAL_ERROR "No benchmark baseline at ${BASELINE}, build the update_benchmark_baseline target to create one")
+endif()
+
+file(READ "${BASELINE}" baselineJson)
+
+# The threshold is a fraction, turn it into a whole percentage for integer maths
+math(EXPR thresholdPercent "0")
+string(REGEX MATCH "^([0-9]*)(\\.([0-9]*))?$" _ "${THRESHOLD}")
+set(thresholdFraction "${CMAKE_MATCH_3}00")
+string(SUBSTRING "${thresholdFraction}" 0 2 thresholdFraction)
+string(REGEX REPLACE "^0" "" thresholdFraction "${thresholdFraction}")
+if(CMAKE_MATCH_1 STREQUAL "")
+    set(CMAKE_MATCH_1 0)
+endif()
+if(thresholdFraction STREQUAL "")
+    set(thresholdFraction 0)
+endif()
+math(EXPR thresholdPercent "${CMAKE_MATCH_1} * 100 + ${thresholdFraction}")
+
+set(regressions 0)
+foreach(name IN LISTS names)
+    string(JSON baseline ERROR_VARIABLE missing GET "${baselineJson}" benchmarks "${name}")
+    if(missing)
+        message(STATUS "NEW        ${name}: no baseline yet")
+        continue()
+    endif()
+
+    math(EXPR limit "${baseline} * (100 + ${thresholdPercent}) / 100")
+    if(baseline GREATER 0)
+        math(EXPR changePercent "(${current_${name}} - ${baseline}) * 100 / ${baseline}")
+    else()
+        set(changePercent 0)
+    endif()
+
+    if(current_${name} GREATER limit)
+        message(STATUS "REGRESSED  ${name}: ${changePercent}% slower than baseline")
+        math(EXPR regressions "${regressions} + 1")
+    else()
+        message(STATUS "OK         ${name}: ${changePercent}% against baseline")
+    endif()
+endforeach()
+
+# Every baseline entry has to have run, unless this build leaves it out on purpose
+set(missingResults 0)
+string(JSON baselineCount LENGTH "${baselineJson}" benchmarks)
+math(EXPR lastBaseline "${baselineCount} - 1")
+foreach(index RANGE ${lastBaseline})
+    string(JSON name MEMBER "${baselineJson}" benchmarks ${index})
+    if(DEFINED "current_${name}")
+        continue()
+    endif()
+    if(name IN_LIST EXCLUDED)
+        message(STATUS "EXCLUDED   ${name}: not built in this configuration")
+    else()
+        message(STATUS "NO RESULT  ${name}: in the baseline but did not run")
+        math(EXPR missingResults "${missingResults} + 1")
+    endif()
+endforeach()
+
+read_budgets("${baselineJson}" budgetNames)
+set(overBudget 0)
+foreach(name IN LISTS budgetNames)
+    if(NOT DEFINED "current_${name}")
+        message(STATUS "NO RESULT  ${name}: has a budget but did not run")
+        math(EXPR overBudget "${overBudget} + 1")
+    elseif(current_${name} GREATER budget_${name})
+        message(STATUS "OVER       ${name}: ${current_${name}} ps against a budget of ${budget_${name}} ps")
+        math(EXPR overBudget "${overBudget} + 1")
+    else()
+        message(STATUS "IN BUDGET  ${name}: ${current_${name}} ps against a budget of ${budget_${name}} ps")
+    endif()
+endforeach()
+
+if(missingResults GREATER 0)
+    message(FATAL_ERROR "${missingResults} benchmark(s) in the baseline did not run")
+endif()
+if(regressions GREATER 0)
+    message(FATAL_ERROR "${regressions} benchmark(s) regressed more than ${thresholdPercent}% against the baseline")
+endif()
+if(overBudget GREATER 0)
+    message(FATAL_ERROR "${overBudget} benchmark(s) missed their absolute budget")
+endif()
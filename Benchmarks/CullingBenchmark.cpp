@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include "../Culling.h"
+#include "../GameWorld.h"
+
+// Culling of trees on a ring round a camera turning one degree a frame, as the chase camera does when the
+// player drives in circles, so some objects change visibility every update
+static void BM_CullingUpdate(benchmark::State& state) {
+    const GameSettings settings;
+    const int numObjects = int(state.range(0));
+    const float ringRadius = settings.perimeterRadius;
+    const float extent = ringRadius + 10.0f;
+    CullingGrid grid(-extent, -extent, extent, extent, 10.0f);
+    for (int i = 0; i < numObjects; i++) {
+        float angle = 360.0f * float(i) / float(numObjects) * degreesToRadians;
+        grid.AddObject({ ringRadius * std::sin(angle), 5.0f, ringRadius * std::cos(angle) }, 6.0f);
+    }
+
+    float heading = 0.0f;
+    for (auto _ : state) {
+        heading += 1.0f;
+        float angle = heading * degreesToRadians;
+        const float cameraMatrix[4][4] = {
+            { std::cos(angle), 0.0f, -std::sin(angle), 0.0f },
+            { 0.0f, 1.0f, 0.0f, 0.0f },
+            { std::sin(angle), 0.0f, std::cos(angle), 0.0f },
+            { 0.0f, 10.0f, 0.0f, 1.0f }
+        };
+        Frustum frustum = calculateFrustum(cameraMatrix, 60.0f, 16.0f / 9.0f, 1.0f, settings.cullDistance);
+        grid.Update(frustum, { 0.0f, 10.0f, 0.0f }, settings.cullDistance);
+        benchmark::DoNotOptimize(grid.GetVisibleCount());
+    }
+
+    state.SetItemsProcessed(state.iterations() * numObjects);
+}
+BENCHMARK(BM_CullingUpdate)->Arg(160)->Arg(16000);
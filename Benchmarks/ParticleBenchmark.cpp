@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include "../ParticleSystem.h"
+
+// Pool settings matching the sparks used in game, with a capacity large enough for the stress test
+static ParticlePoolSettings StressPoolSettings(int capacity) {
+    return { capacity, 256, -30.0f, 0.5f, 0.4f, 0.0f };
+}
+
+// Fill a pool with particles that live long enough to stay alive for the whole benchmark
+static void FillPool(ParticlePool& pool, int count) {
+    for (int i = 0; i < count; i++) {
+        float offset = float(i % 1000);
+        pool.Spawn({ offset * 0.01f, 1.0f + offset * 0.001f, -offset * 0.01f }, { 1.0f, 5.0f, -1.0f }, 1.0e6f);
+    }
+}
+
+// Update of a full pool, the game budget is 100k live particles in under 1 ms (the budget in baseline.json)
+static void BM_ParticleUpdate(benchmark::State& state) {
+    const int count = int(state.range(0));
+    ParticlePool pool(StressPoolSettings(count));
+    FillPool(pool, count);
+
+    for (auto _ : state) {
+        pool.Update(1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["live"] = double(pool.GetLiveCount());
+}
+BENCHMARK(BM_ParticleUpdate)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// Picking and sorting the particles nearest the camera for drawing
+static void BM_ParticleDrawList(benchmark::State& state) {
+    const int count = int(state.range(0));
+    ParticlePool pool(StressPoolSettings(count));
+    FillPool(pool, count);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool.BuildDrawList({ 0.0f, 15.0f, -60.0f }));
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParticleDrawList)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// Steady state with emitters continuously replacing particles as they die
+static void BM_ParticleSystemSteadyState(benchmark::State& state) {
+    ParticlePoolSettings poolSettings[NUM_PARTICLE_KINDS] = {
+        StressPoolSettings(100000),
+        StressPoolSettings(20000)
+    };
+    ParticleSystem particles(poolSettings, 64);
+
+    const EmitterSettings sparks = { PARTICLE_SPARK, 0.5f, 50000.0f, 8.0f, 1.0f, 1.0f, 1.0f };
+    const EmitterSettings debris = { PARTICLE_DEBRIS, 0.5f, 10000.0f, 4.0f, 1.0f, 1.5f, 1.0f };
+
+    for (auto _ : state) {
+        particles.StartEmitter(sparks, { 0.0f, 1.0f, 0.0f });
+        particles.StartEmitter(debris, { 0.0f, 1.0f, 0.0f });
+        particles.Update(1.0f / 60.0f);
+    }
+
+    state.counters["live"] = double(particles.GetLiveCount());
+}
+BENCHMARK(BM_ParticleSystemSteadyState)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "../Telemetry.h"
+
+// Cost to the game loop of emitting an event. Each iteration emits a burst that fits in the queue, then waits
+// untimed for the writer thread to drain it, so the time measured is the normal path and not the full queue path.
+static void BM_TelemetryEmit(benchmark::State& state) {
+    const std::string logPath = "benchmark_telemetry.bin";
+    const int eventsPerBurst = 4096;
+    Telemetry telemetry(eventsPerBurst * 4);
+    telemetry.Start(logPath);
+
+    TelemetryEvent event = { 1.0f, -4.0f, 25, 2, 15, 99, 0, TELEMETRY_MOVING_CAR_HIT, HIT_SIDE };
+
+    for (auto _ : state) {
+        for (int i = 0; i < eventsPerBurst; i++) {
+            event.time += 0.001f;
+            telemetry.Emit(event);
+        }
+
+        state.PauseTiming();
+        while (telemetry.GetQueuedEvents() != 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        state.ResumeTiming();
+    }
+
+    telemetry.Stop();
+    state.SetItemsProcessed(state.iterations() * eventsPerBurst);
+    state.counters["time_per_event"] = benchmark::Counter(double(eventsPerBurst),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    if (telemetry.GetDroppedEvents() != 0) {
+        state.SkipWithError("Events were dropped, the burst no longer fits in the queue");
+    }
+    std::remove(logPath.c_str());
+}
+// Fixed iterations, as waiting for the writer to drain takes far longer than the timed part
+BENCHMARK(BM_TelemetryEmit)->Iterations(200);
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include "../GameWorld.h"
+#include "../VehicleDynamics.h"
+
+static const float frameTime = 1.0f / 60.0f;
+
+// One fixed step of the bicycle model for a single car turning at full throttle
+static void BM_VehicleIntegrate(benchmark::State& state) {
+    const GameSettings settings;
+    const VehicleParameters parameters = makeVehicleParameters(settings);
+    VehicleState vehicle = makeVehicleState({ 0, 0, 0 }, 0.0f);
+    const VehicleControls controls = { 1.0f, 1.0f };
+
+    for (auto _ : state) {
+        integrateVehicle(parameters, controls, vehicle, 1.0f / settings.physicsStepRate);
+        benchmark::DoNotOptimize(vehicle);
+    }
+}
+BENCHMARK(BM_VehicleIntegrate);
+
+// A frame of AI traffic, every car in the batch running its fixed steps with its own controls
+static void BM_VehicleBatchStep(benchmark::State& state) {
+    const GameSettings settings;
+    const int numVehicles = int(state.range(0));
+    VehicleBatch batch(makeVehicleParameters(settings), settings.physicsStepRate, settings.maxPhysicsStepsPerFrame);
+
+    for (int i = 0; i < numVehicles; i++) {
+        int vehicle = batch.AddVehicle(makeVehicleState({ float(i % 100) * 5.0f, 0.0f, float(i / 100) * 5.0f }, float(i)));
+        batch.SetControls(vehicle, { (i % 4 == 0) ? -1.0f : 1.0f, float(i % 3) - 1.0f });
+    }
+
+    for (auto _ : state) {
+        batch.Step(frameTime);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * numVehicles);
+}
+BENCHMARK(BM_VehicleBatchStep)->Arg(1000)->Arg(10000);
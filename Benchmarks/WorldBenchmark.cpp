@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include "../GameWorld.h"
+
+static const float frameTime = 1.0f / 60.0f;
+
+// Player holding accelerate and right, which drives it round in circles hitting cars and trees
+static const DriveInput circlingInput = { true, false, false, true };
+
+// Bounding box test of the player at points around an enemy car, about half of them colliding
+static void BM_CheckCollision(benchmark::State& state) {
+    const GameSettings settings;
+    const int numPositions = 64;
+    Vector3 players[numPositions];
+    for (int i = 0; i < numPositions; i++) {
+        players[i] = { float(i % 8) - 4.0f, 0.0f, float(i / 8) - 4.0f };
+    }
+    Vector3 enemy = { 0.0f, 0.0f, 0.0f };
+
+    for (auto _ : state) {
+        int collisions = 0;
+        for (int i = 0; i < numPositions; i++) {
+            collisions += CheckCollision(players[i], enemy, settings.playerCarRadius, settings.enemyStaticCar);
+        }
+        benchmark::DoNotOptimize(collisions);
+    }
+
+    state.SetItemsProcessed(state.iterations() * numPositions);
+}
+BENCHMARK(BM_CheckCollision);
+
+// Contact check of the player against every perimeter tree, done once per physics step.
+// The tree count is a constant when the tuning values are baked in, so there is no world to size.
+#ifndef GAME_TUNING_BAKED
+static void BM_TreeScan(benchmark::State& state) {
+    GameSettings settings;
+    settings.noOfTrees = int(state.range(0));
+    GameWorld world(settings);
+
+    for (auto _ : state) {
+        world.ResolveTreeContacts();
+    }
+
+    state.SetItemsProcessed(state.iterations() * settings.noOfTrees);
+}
+BENCHMARK(BM_TreeScan)->Arg(160)->Arg(16000);
+#endif
+
+// Movement, sphere bobbing and reset timers of the moving enemies
+static void BM_EnemyTick(benchmark::State& state) {
+    GameWorld world;
+
+    for (auto _ : state) {
+        world.UpdateMovingEnemies(frameTime);
+    }
+}
+BENCHMARK(BM_EnemyTick);
+
+// A whole frame of gameplay with the default 160 trees and 8 enemies
+static void BM_WorldStep(benchmark::State& state) {
+    GameWorld world;
+
+    for (auto _ : state) {
+        world.Step(circlingInput, frameTime);
+        benchmark::DoNotOptimize(world.GetEvents().data());
+    }
+}
+BENCHMARK(BM_WorldStep);
+
+// Putting the world back to its starting state, after a frame of play so there is something to undo
+static void BM_Restart(benchmark::State& state) {
+    GameWorld world;
+
+    for (auto _ : state) {
+        world.Step(circlingInput, frameTime);
+        world.Restart();
+    }
+}
+BENCHMARK(BM_Restart);
@@ -0,0 +1,187 @@
+#include "Culling.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Turn a direction given in camera space into world space using the camera axes
+static Vector3 cameraToWorld(const Vector3 axes[3], float x, float y, float z) {
+    return { axes[0].x * x + axes[1].x * y + axes[2].x * z,
+             axes[0].y * x + axes[1].y * y + axes[2].y * z,
+             axes[0].z * x + axes[1].z * y + axes[2].z * z };
+}
+
+static Plane makePlane(const Vector3& normal, const Vector3& pointOnPlane) {
+    float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+    Vector3 unitNormal = { normal.x / length, normal.y / length, normal.z / length };
+    float distance = -(unitNormal.x * pointOnPlane.x + unitNormal.y * pointOnPlane.y + unitNormal.z * pointOnPlane.z);
+    return { unitNormal, distance };
+}
+
+Frustum calculateFrustum(const float cameraMatrix[4][4], float verticalFieldOfView, float aspectRatio,
+                         float nearClip, float farClip) {
+
+    // Normalise the camera axes so a scaled camera still gives unit plane normals
+    Vector3 axes[3];
+    for (int i = 0; i < 3; i++) {
+        float length = std::sqrt(cameraMatrix[i][0] * cameraMatrix[i][0] +
+                                 cameraMatrix[i][1] * cameraMatrix[i][1] +
+                                 cameraMatrix[i][2] * cameraMatrix[i][2]);
+        axes[i] = { cameraMatrix[i][0] / length, cameraMatrix[i][1] / length, cameraMatrix[i][2] / length };
+    }
+    Vector3 position = { cameraMatrix[3][0], cameraMatrix[3][1], cameraMatrix[3][2] };
+
+    float tanHalfHeight = std::tan(verticalFieldOfView * 0.5f * degreesToRadians);
+    float tanHalfWidth = tanHalfHeight * aspectRatio;
+
+    Frustum frustum;
+
+    Vector3 forward = axes[2];
+    Vector3 nearPoint = { position.x + forward.x * nearClip, position.y + forward.y * nearClip, position.z + forward.z * nearClip };
+    Vector3 farPoint = { position.x + forward.x * farClip, position.y + forward.y * farClip, position.z + forward.z * farClip };
+    Vector3 backward = { -forward.x, -forward.y, -forward.z };
+
+    // Side planes pass through the camera position, TL-Engine cameras look down their local z axis
+    frustum.planes[0] = makePlane(forward, nearPoint);
+    frustum.planes[1] = makePlane(backward, farPoint);
+    frustum.planes[2] = makePlane(cameraToWorld(axes, 1.0f, 0.0f, tanHalfWidth), position);
+    frustum.planes[3] = makePlane(cameraToWorld(axes, -1.0f, 0.0f, tanHalfWidth), position);
+    frustum.planes[4] = makePlane(cameraToWorld(axes, 0.0f, -1.0f, tanHalfHeight), position);
+    frustum.planes[5] = makePlane(cameraToWorld(axes, 0.0f, 1.0f, tanHalfHeight), position);
+
+    const float clipDistances[2] = { nearClip, farClip };
+    for (int i = 0; i < 2; i++) {
+        float depth = clipDistances[i];
+        for (int corner = 0; corner < 4; corner++) {
+            float x = (corner & 1 ? tanHalfWidth : -tanHalfWidth) * depth;
+            float y = (corner & 2 ? tanHalfHeight : -tanHalfHeight) * depth;
+            Vector3 offset = cameraToWorld(axes, x, y, depth);
+            frustum.corners[i * 4 + corner] = { position.x + offset.x, position.y + offset.y, position.z + offset.z };
+        }
+    }
+
+    return frustum;
+}
+
+bool isSphereInFrustum(const Frustum& frustum, const Vector3& centre, float radius) {
+    for (const Plane& plane : frustum.planes) {
+        float distance = plane.normal.x * centre.x + plane.normal.y * centre.y + plane.normal.z * centre.z + plane.distance;
+        if (distance < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CullingGrid::CullingGrid(float minX, float minZ, float maxX, float maxZ, float cellSize)
+    : cellSize(cellSize) {
+    SetBounds(minX, minZ, maxX, maxZ);
+}
+
+void CullingGrid::SetBounds(float newMinX, float newMinZ, float maxX, float maxZ) {
+    minX = newMinX;
+    minZ = newMinZ;
+    cellsX = std::max(1, int(std::ceil((maxX - minX) / cellSize)));
+    cellsZ = std::max(1, int(std::ceil((maxZ - minZ) / cellSize)));
+
+    cells.assign(cellsX * cellsZ, std::vector<int>());
+    for (int id = 0; id < int(objects.size()); id++) {
+        objects[id].cell = CellIndex(objects[id].centre.x, objects[id].centre.z);
+        cells[objects[id].cell].push_back(id);
+    }
+}
+
+// Objects outside the grid are kept in the nearest edge cell so they are still tested
+int CullingGrid::CellIndex(float x, float z) const {
+    int cellX = std::min(std::max(int((x - minX) / cellSize), 0), cellsX - 1);
+    int cellZ = std::min(std::max(int((z - minZ) / cellSize), 0), cellsZ - 1);
+    return cellZ * cellsX + cellX;
+}
+
+int CullingGrid::AddObject(const Vector3& centre, float radius) {
+    int id = int(objects.size());
+    int cell = CellIndex(centre.x, centre.z);
+
+    // Models start out visible, so the first update hides the ones the camera cannot see
+    objects.push_back({ centre, radius, cell, -1, true });
+    cells[cell].push_back(id);
+    visibleObjects.push_back(id);
+    largestRadius = std::max(largestRadius, radius);
+
+    return id;
+}
+
+void CullingGrid::RemoveFromCell(int id, int cell) {
+    std::vector<int>& cellObjects = cells[cell];
+    auto found = std::find(cellObjects.begin(), cellObjects.end(), id);
+    *found = cellObjects.back();
+    cellObjects.pop_back();
+}
+
+void CullingGrid::MoveObject(int id, const Vector3& centre) {
+    CullObject& object = objects[id];
+    object.centre = centre;
+
+    int cell = CellIndex(centre.x, centre.z);
+    if (cell != object.cell) {
+        RemoveFromCell(id, object.cell);
+        cells[cell].push_back(id);
+        object.cell = cell;
+    }
+}
+
+void CullingGrid::Update(const Frustum& frustum, const Vector3& cameraPosition, float farClip) {
+    updateCount++;
+    std::swap(previousVisibleObjects, visibleObjects);
+    visibleObjects.clear();
+    shownObjects.clear();
+    hiddenObjects.clear();
+
+    // Only visit the cells under the frustum, widened by the largest radius so objects poking into it still count
+    float boundsMinX = frustum.corners[0].x;
+    float boundsMaxX = frustum.corners[0].x;
+    float boundsMinZ = frustum.corners[0].z;
+    float boundsMaxZ = frustum.corners[0].z;
+    for (const Vector3& corner : frustum.corners) {
+        boundsMinX = std::min(boundsMinX, corner.x);
+        boundsMaxX = std::max(boundsMaxX, corner.x);
+        boundsMinZ = std::min(boundsMinZ, corner.z);
+        boundsMaxZ = std::max(boundsMaxZ, corner.z);
+    }
+
+    int firstCell = CellIndex(boundsMinX - largestRadius, boundsMinZ - largestRadius);
+    int lastCell = CellIndex(boundsMaxX + largestRadius, boundsMaxZ + largestRadius);
+
+    for (int cellZ = firstCell / cellsX; cellZ <= lastCell / cellsX; cellZ++) {
+        for (int cellX = firstCell % cellsX; cellX <= lastCell % cellsX; cellX++) {
+            for (int id : cells[cellZ * cellsX + cellX]) {
+                CullObject& object = objects[id];
+
+                float dx = object.centre.x - cameraPosition.x;
+                float dy = object.centre.y - cameraPosition.y;
+                float dz = object.centre.z - cameraPosition.z;
+                float range = farClip + object.radius;
+
+                if (dx * dx + dy * dy + dz * dz > range * range ||
+                    !isSphereInFrustum(frustum, object.centre, object.radius)) {
+                    continue;
+                }
+
+                object.lastVisibleUpdate = updateCount;
+                visibleObjects.push_back(id);
+                if (object.visible == false) {
+                    object.visible = true;
+                    shownObjects.push_back(id);
+                }
+            }
+        }
+    }
+
+    // Anything visible last update that was not seen this time has just been culled
+    for (int id : previousVisibleObjects) {
+        CullObject& object = objects[id];
+        if (object.lastVisibleUpdate != updateCount) {
+            object.visible = false;
+            hiddenObjects.push_back(id);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+
+#include "GameMath.h"
+
+// Plane stored as a unit normal pointing into the frustum and a distance, points inside give a positive result
+struct Plane {
+    Vector3 normal;
+    float distance;
+};
+
+// Camera view volume made of six planes (near, far, left, right, top, bottom) and its eight corners
+struct Frustum {
+    Plane planes[6];
+    Vector3 corners[8];
+};
+
+// Build the view frustum from a TL-Engine style world matrix (rows are the x, y, z axes then the position)
+Frustum calculateFrustum(const float cameraMatrix[4][4], float verticalFieldOfView, float aspectRatio,
+                         float nearClip, float farClip);
+
+// Check if a bounding sphere is at least partly inside the frustum
+bool isSphereInFrustum(const Frustum& frustum, const Vector3& centre, float radius);
+
+// Frustum and distance culling of bounding spheres, using a uniform grid on the ground plane so only the
+// cells the camera can see are tested
+class CullingGrid {
+public:
+    CullingGrid(float minX, float minZ, float maxX, float maxZ, float cellSize);
+
+    // Register an object and return the id used to move it and to read back its visibility
+    int AddObject(const Vector3& centre, float radius);
+
+    // Change the area the grid covers and sort every object into the new cells, ids and visibility are kept
+    void SetBounds(float minX, float minZ, float maxX, float maxZ);
+
+    // Update the position of a moving object, it only changes cell when it crosses a cell boundary
+    void MoveObject(int id, const Vector3& centre);
+
+    // Work out which objects can be seen, farClip in the frustum doubles as the distance culling range
+    void Update(const Frustum& frustum, const Vector3& cameraPosition, float farClip);
+
+    // Objects whose visibility changed in the last update
+    const std::vector<int>& GetShownObjects() const { return shownObjects; }
+    const std::vector<int>& GetHiddenObjects() const { return hiddenObjects; }
+
+    bool IsVisible(int id) const { return objects[id].visible; }
+    int GetObjectCount() const { return int(objects.size()); }
+    int GetVisibleCount() const { return int(visibleObjects.size()); }
+    int GetCulledCount() const { return GetObjectCount() - GetVisibleCount(); }
+
+private:
+    struct CullObject {
+        Vector3 centre;
+        float radius;
+        int cell;
+        int lastVisibleUpdate;
+        bool visible;
+    };
+
+    int CellIndex(float x, float z) const;
+    void RemoveFromCell(int id, int cell);
+
+    float minX;
+    float minZ;
+    float cellSize;
+    int cellsX;
+    int cellsZ;
+    float largestRadius = 0.0f;
+    int updateCount = 0;
+
+    std::vector<CullObject> objects;
+    std::vector<std::vector<int>> cells;
+    std::vector<int> visibleObjects;
+    std::vector<int> previousVisibleObjects;
+    std::vector<int> shownObjects;
+    std::vector<int> hiddenObjects;
+};
@@ -0,0 +1,34 @@
+#include "GameMath.h"
+
+#include <cmath>
+
+float calculateDotProduct(Vector3 v, Vector3 w) {
+    return (v.x * w.x + v.y * w.y + v.z * w.z);
+}
+
+float calculateModulus(Vector3 v) {
+    return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+// TL-Engine is left handed, so turning about y moves the local z axis towards x
+Vector3 calculateFacingVector(float rotationY) {
+    return { std::sin(rotationY * degreesToRadians), 0.0f, std::cos(rotationY * degreesToRadians) };
+}
+
+bool CheckCollision(const Vector3& playerCar, const Vector3& enemyCar, float playerCarRadius, const BoundingBox& box) {
+
+    // Calculate the min and max bounds of the bounding box, considering the player's car radius
+    float boxminX = (enemyCar.x + box.minX) - playerCarRadius;
+    float boxmaxX = (enemyCar.x + box.maxX) + playerCarRadius;
+    float boxminY = (enemyCar.y + box.minY) - playerCarRadius;
+    float boxmaxY = (enemyCar.y + box.maxY) + playerCarRadius;
+    float boxminZ = (enemyCar.z + box.minZ) - playerCarRadius;
+    float boxmaxZ = (enemyCar.z + box.maxZ) + playerCarRadius;
+
+    // Check for collision using bounding box and player's car position
+    bool isCollision = (playerCar.x > boxminX && playerCar.x < boxmaxX &&
+        playerCar.y > boxminY && playerCar.y < boxmaxY &&
+        playerCar.z > boxminZ && playerCar.z < boxmaxZ);
+
+    return isCollision;
+}
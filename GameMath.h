@@ -0,0 +1,36 @@
+#pragma once
+
+// SSE2 is always there on x64 and on x86 builds targeting it. Code with a SIMD path includes <emmintrin.h>
+// and uses it when this is defined, with a plain loop otherwise.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GAME_USE_SSE 1
+#endif
+
+const float degreesToRadians = 3.14159265f / 180.0f;
+
+// Struct to represent a 3D vector with x, y, and z components
+struct Vector3 {
+    float x, y, z;
+};
+
+// Struct to represent a bounding box with min and max values along x, y, and z axes
+struct BoundingBox {
+    float minX;
+    float maxX;
+    float minY;
+    float maxY;
+    float minZ;
+    float maxZ;
+};
+
+// Calculate the dot product of two 3D vectors
+float calculateDotProduct(Vector3 v, Vector3 w);
+
+// Calculate the modulus (magnitude) of a 3D vector
+float calculateModulus(Vector3 v);
+
+// Calculate the facing vector of a model rotated about the y axis by the given angle in degrees
+Vector3 calculateFacingVector(float rotationY);
+
+// Check for collision between the player's car and an enemy car using bounding box and player's car radius
+bool CheckCollision(const Vector3& playerCar, const Vector3& enemyCar, float playerCarRadius, const BoundingBox& box);
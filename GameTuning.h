@@ -0,0 +1,98 @@
+#pragma once
+
+// Every tuning value in the game, defined once as type, name, default value and the smallest and largest value
+// that is allowed. The list is expanded into the members of GameSettings, and into the names and ranges the
+// tuning config file is read with (TuningConfig.cpp), which rejects a file with a value outside its range.
+// Changing a default here changes it everywhere; tuning.cfg only needs the values that differ.
+//
+// Code reads the values as plain members of GameSettings, so a read is a single load from the settings the
+// game already holds. Building with GAME_TUNING_BAKED turns them into static constexpr members instead, so
+// release builds get the defaults as compile time constants and no config file is read.
+#define GAME_TUNING_PARAMETERS(PARAMETER)                               \
+    /* World layout, the trees are placed once at start up */           \
+    PARAMETER(float, groundYPosition, 0.0f, -100.0f, 100.0f)            \
+    PARAMETER(float, perimeterRadius, 50.0f, 10.0f, 500.0f)             \
+    PARAMETER(int, noOfTrees, 160, 1, 1000)                             \
+                                                                        \
+    PARAMETER(float, playerCarRadius, 2.0f, 0.1f, 10.0f)                \
+    PARAMETER(float, treeRadius, 1.0f, 0.1f, 10.0f)                     \
+    PARAMETER(int, startingHealth, 100, 1, 10000)                       \
+                                                                        \
+    /* Driving */                                                       \
+    PARAMETER(float, maxForwardVelocity, 30.0f, 1.0f, 200.0f)           \
+    PARAMETER(float, maxBackwardVelocity, -30.0f, -200.0f, 0.0f)        \
+    /* Wheel spin in degrees per unit driven, only for the animation */ \
+    PARAMETER(float, wheelSpinFactor, 100.0f, 0.0f, 1000.0f)            \
+    PARAMETER(float, acceleration, 30.0f, 0.1f, 1000.0f)                \
+    PARAMETER(float, deceleration, 30.0f, 0.0f, 1000.0f)                \
+    PARAMETER(float, maxWheelRotation, 30.0f, 0.0f, 45.0f)              \
+    PARAMETER(float, wheelSteeringSpeed, 180.0f, 1.0f, 3600.0f)         \
+    PARAMETER(float, wheelBase, 2.5f, 0.5f, 10.0f)                      \
+    PARAMETER(float, lateralGrip, 40.0f, 0.0f, 1000.0f)                 \
+    PARAMETER(float, bounceFactor, 0.5f, 0.0f, 1.0f)                    \
+    PARAMETER(float, physicsStepRate, 120.0f, 30.0f, 1000.0f)           \
+    PARAMETER(int, maxPhysicsStepsPerFrame, 8, 1, 64)                   \
+                                                                        \
+    /* Scoring */                                                       \
+    PARAMETER(float, sideCollisionChecker, 3.5f, 0.0f, 100.0f)          \
+    PARAMETER(int, scoreIncreaseForSideCollision, 15, 0, 1000)          \
+    PARAMETER(int, scoreIncreaseForFrontCollision, 10, 0, 1000)         \
+                                                                        \
+    /* Enemy cars and their spheres */                                  \
+    PARAMETER(float, carMovementSpeed, 15.0f, 0.0f, 100.0f)             \
+    PARAMETER(float, movingCarRange, 30.0f, 0.0f, 200.0f)               \
+    PARAMETER(float, enemySphereYPosition, 2.5f, 0.0f, 20.0f)           \
+    PARAMETER(float, sphereMovingMinRange, 2.5f, 0.0f, 20.0f)           \
+    PARAMETER(float, sphereMovingMaxRange, 3.0f, 0.0f, 20.0f)           \
+    PARAMETER(float, sphereMovementSpeedDefault, 2.5f, 0.0f, 50.0f)     \
+    PARAMETER(float, sphereMovementSpeedDecrease, 1.125f, 0.0f, 50.0f)  \
+    PARAMETER(int, resetCarTimeDefault, 0, 0, 1000)                     \
+    PARAMETER(float, resetCarTimeThreshold1, 3.0f, 0.0f, 600.0f)        \
+    PARAMETER(float, resetCarTimeThreshold2, 15.0f, 0.0f, 600.0f)       \
+                                                                        \
+    /* Camera, the tilt is set once when the camera is made */          \
+    PARAMETER(float, cameraDefaultX, 0.0f, -500.0f, 500.0f)             \
+    PARAMETER(float, cameraDefaultY, 15.0f, -500.0f, 500.0f)            \
+    PARAMETER(float, cameraDefaultZ, -60.0f, -500.0f, 500.0f)           \
+    PARAMETER(float, cameraRotationX, 15.0f, -90.0f, 90.0f)             \
+    PARAMETER(float, cameraAttachedX, 0.0f, -100.0f, 100.0f)            \
+    PARAMETER(float, cameraAttachedY1, 5.0f, -100.0f, 100.0f)           \
+    PARAMETER(float, cameraAttachedY2, 2.0f, -100.0f, 100.0f)           \
+    PARAMETER(float, cameraAttachedZ, -15.0f, -100.0f, 100.0f)          \
+    PARAMETER(float, cameraBonnetZ, 0.0f, -100.0f, 100.0f)              \
+    PARAMETER(float, cullDistance, 200.0f, 10.0f, 5000.0f)              \
+                                                                        \
+    /* Hit effects */                                                   \
+    PARAMETER(float, scaleFactor, 0.6f, 0.05f, 1.0f)                    \
+    PARAMETER(float, impactHeight, 1.0f, 0.0f, 20.0f)                   \
+    PARAMETER(float, particleGravity, -30.0f, -200.0f, 0.0f)            \
+    PARAMETER(float, sparkDrag, 1.5f, 0.0f, 20.0f)                      \
+    PARAMETER(float, sparkRestitution, 0.3f, 0.0f, 1.0f)                \
+    PARAMETER(float, debrisDrag, 0.5f, 0.0f, 20.0f)                     \
+    PARAMETER(float, debrisRestitution, 0.4f, 0.0f, 1.0f)               \
+                                                                        \
+    /* Particle emitters started by a hit on a tree or a car */         \
+    PARAMETER(float, treeSparkDuration, 0.05f, 0.0f, 5.0f)              \
+    PARAMETER(float, treeSparkRate, 400.0f, 0.0f, 10000.0f)             \
+    PARAMETER(float, treeSparkSpeed, 6.0f, 0.0f, 100.0f)                \
+    PARAMETER(float, treeSparkSpread, 1.0f, 0.0f, 10.0f)                \
+    PARAMETER(float, treeSparkUpwardBias, 0.8f, 0.0f, 10.0f)            \
+    PARAMETER(float, treeSparkLifetime, 0.5f, 0.05f, 10.0f)             \
+    PARAMETER(float, treeDebrisDuration, 0.05f, 0.0f, 5.0f)             \
+    PARAMETER(float, treeDebrisRate, 200.0f, 0.0f, 10000.0f)            \
+    PARAMETER(float, treeDebrisSpeed, 4.0f, 0.0f, 100.0f)               \
+    PARAMETER(float, treeDebrisSpread, 1.0f, 0.0f, 10.0f)               \
+    PARAMETER(float, treeDebrisUpwardBias, 1.5f, 0.0f, 10.0f)           \
+    PARAMETER(float, treeDebrisLifetime, 1.5f, 0.05f, 10.0f)            \
+    PARAMETER(float, carSparkDuration, 0.1f, 0.0f, 5.0f)                \
+    PARAMETER(float, carSparkRate, 600.0f, 0.0f, 10000.0f)              \
+    PARAMETER(float, carSparkSpeed, 10.0f, 0.0f, 100.0f)                \
+    PARAMETER(float, carSparkSpread, 1.0f, 0.0f, 10.0f)                 \
+    PARAMETER(float, carSparkUpwardBias, 0.6f, 0.0f, 10.0f)             \
+    PARAMETER(float, carSparkLifetime, 0.6f, 0.05f, 10.0f)              \
+    PARAMETER(float, carDebrisDuration, 0.1f, 0.0f, 5.0f)               \
+    PARAMETER(float, carDebrisRate, 300.0f, 0.0f, 10000.0f)             \
+    PARAMETER(float, carDebrisSpeed, 6.0f, 0.0f, 100.0f)                \
+    PARAMETER(float, carDebrisSpread, 1.0f, 0.0f, 10.0f)                \
+    PARAMETER(float, carDebrisUpwardBias, 1.2f, 0.0f, 10.0f)            \
+    PARAMETER(float, carDebrisLifetime, 2.0f, 0.05f, 10.0f)
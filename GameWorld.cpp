@@ -0,0 +1,385 @@
+#include "GameWorld.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Starting positions of the enemy cars
+static const float enemyStaticCarPositions[numStaticEnemies][2] = {
+    { -20, 20 },
+    { 20, 20 },
+    { -20, 0 },
+    { 20, 0 }
+};
+
+static const float enemyMovingCarPositions[numMovingEnemies][2] = {
+    { -30, 15 },
+    { 30, -15 },
+    { 30, 30 },
+    { -30, -30 }
+};
+
+// Enough room for every enemy and a few trees to be hit in the same frame without reallocating
+static const int eventsReserved = 64;
+
+// Every default has to be a value the tuning config file would accept
+#define CHECK_TUNING_DEFAULT(type, name, value, minValue, maxValue) \
+    static_assert(value >= minValue && value <= maxValue, #name " default is outside its range");
+GAME_TUNING_PARAMETERS(CHECK_TUNING_DEFAULT)
+#undef CHECK_TUNING_DEFAULT
+
+// The moving cars are turned a quarter turn to drive along x, so their box is turned with them
+static BoundingBox rotateBoxQuarterTurn(const BoundingBox& box) {
+    return { box.minZ, box.maxZ, box.minY, box.maxY, -box.maxX, -box.minX };
+}
+
+VehicleParameters makeVehicleParameters(const GameSettings& settings) {
+    return { settings.acceleration, settings.deceleration, settings.maxForwardVelocity, settings.maxBackwardVelocity,
+             settings.wheelBase, settings.lateralGrip, settings.maxWheelRotation, settings.wheelSteeringSpeed,
+             settings.bounceFactor, settings.playerCarRadius };
+}
+
+GameWorld::GameWorld(const GameSettings& settings)
+    : settings(settings),
+      physicsStepper(settings.physicsStepRate, settings.maxPhysicsStepsPerFrame) {
+
+    vehicleParameters = makeVehicleParameters(settings);
+    movingCarBox = rotateBoxQuarterTurn(settings.enemyMovingCar);
+
+    for (int i = 0; i < settings.noOfTrees; i++) {
+        float angle = (2 * 3.14 / settings.noOfTrees) * i;
+        float treeXPos = settings.perimeterRadius * sin(angle);
+        float treeYPos = settings.perimeterRadius * cos(angle);
+        trees.push_back({ treeXPos, settings.groundYPosition, treeYPos });
+    }
+
+    events.reserve(eventsReserved);
+    treeContacts.reserve(eventsReserved);
+
+    player = { { 0, 0, 0 }, 0.0f, 0.0f, 0.0f, false, false };
+    playerVehicle = makeVehicleState({ 0, 0, 0 }, 0.0f);
+    dotProduct = 0.0f;
+
+    for (int i = 0; i < numStaticEnemies; i++) {
+        staticEnemies[i].rotationY = 0.0f;
+        staticEnemies[i].carSideHit = false;
+    }
+
+    for (int i = 0; i < numMovingEnemies; i++) {
+        movingEnemies[i].rotationY = (i == 0 || i == 3) ? 90.0f : -90.0f;
+        movingEnemies[i].carSideHit = false;
+    }
+
+    Restart();
+}
+
+void GameWorld::Restart() {
+    score = 0;
+    playerHealth = settings.startingHealth;
+    elapsedTime = 0.0f;
+
+    // The front wheel models still carry the steering from before the restart, turn them back to straight
+    wheelSteerChange = -playerVehicle.steerAngle;
+    playerVehicle = makeVehicleState({ 0, 0, 0 }, 0.0f);
+    physicsStepper.Reset();
+    SyncPlayer();
+
+    moveOppositeCar1 = false;
+    moveOppositeCar2 = false;
+    moveOppositeSphere = false;
+
+    allStaticCarsHit = false;
+    allMovingCarsHit = false;
+
+    wheelSpinAngle = 0.0f;
+
+    for (int i = 0; i < numStaticEnemies; i++) {
+        EnemyCar& enemy = staticEnemies[i];
+        enemy.position = { enemyStaticCarPositions[i][0], settings.groundYPosition, enemyStaticCarPositions[i][1] };
+        enemy.velocity = { 0, 0, 0 };
+        enemy.sphereHeight = settings.enemySphereYPosition;
+        enemy.sphereMovementSpeed = settings.sphereMovementSpeedDefault;
+        enemy.resetCarTime = 0;
+        enemy.carHitStatus = false;
+        enemy.carMovementStatus = true;
+        enemy.sphereMovementStatus = true;
+    }
+
+    for (int i = 0; i < numMovingEnemies; i++) {
+        EnemyCar& enemy = movingEnemies[i];
+        enemy.position = { enemyMovingCarPositions[i][0], settings.groundYPosition, enemyMovingCarPositions[i][1] };
+        enemy.velocity = { 0, 0, 0 };
+        enemy.sphereHeight = settings.enemySphereYPosition;
+        enemy.sphereMovementSpeed = settings.sphereMovementSpeedDefault;
+        enemy.resetCarTime = 0;
+        enemy.carHitStatus = false;
+        enemy.carMovementStatus = true;
+        enemy.sphereMovementStatus = true;
+    }
+
+    events.clear();
+    treeContacts.clear();
+}
+
+#ifndef GAME_TUNING_BAKED
+void GameWorld::SetSettings(const GameSettings& newSettings) {
+    const int noOfTrees = settings.noOfTrees;
+    const float perimeterRadius = settings.perimeterRadius;
+
+    settings = newSettings;
+    settings.noOfTrees = noOfTrees;
+    settings.perimeterRadius = perimeterRadius;
+
+    vehicleParameters = makeVehicleParameters(settings);
+    physicsStepper = FixedStepper(settings.physicsStepRate, settings.maxPhysicsStepsPerFrame);
+}
+#endif
+
+void GameWorld::Step(const DriveInput& input, float frameTime) {
+    events.clear();
+    elapsedTime += frameTime;
+
+    UpdateDriving(input, frameTime);
+    ApplyContacts();
+    UpdateMovingEnemies(frameTime);
+    UpdateWinCondition();
+}
+
+void GameWorld::UpdateDriving(const DriveInput& input, float frameTime) {
+    const bool steerRight = input.right && !input.left;
+    const bool steerLeft = input.left && !input.right;
+
+    // Holding both pedals cancels out, as it did when forward and backward speeds were kept separately
+    VehicleControls controls;
+    controls.throttle = (input.forward ? 1.0f : 0.0f) - (input.backward ? 1.0f : 0.0f);
+    controls.steer = steerRight ? 1.0f : (steerLeft ? -1.0f : 0.0f);
+
+    treeContacts.clear();
+    std::fill(staticEnemyContacts, staticEnemyContacts + numStaticEnemies, false);
+    std::fill(movingEnemyContacts, movingEnemyContacts + numMovingEnemies, false);
+
+    const float previousWheelRotation = playerVehicle.steerAngle;
+    const float stepTime = physicsStepper.GetStepTime();
+    const int steps = physicsStepper.Advance(frameTime);
+
+    wheelSpinAngle = 0.0f;
+    for (int step = 0; step < steps; step++) {
+        integrateVehicle(vehicleParameters, controls, playerVehicle, stepTime);
+        wheelSpinAngle += calculateForwardSpeed(playerVehicle) * stepTime * settings.wheelSpinFactor;
+
+        ResolveTreeContacts();
+        ResolveEnemyContacts();
+    }
+
+    player.turningRight = steerRight;
+    player.turningLeft = steerLeft;
+    wheelSteerChange = playerVehicle.steerAngle - previousWheelRotation;
+    SyncPlayer();
+}
+
+void GameWorld::SyncPlayer() {
+    player.position = playerVehicle.position;
+    player.rotationY = calculateVehicleRotationY(playerVehicle);
+    player.forwardSpeed = calculateForwardSpeed(playerVehicle);
+    player.currentWheelRotation = playerVehicle.steerAngle;
+}
+
+float GameWorld::CalculateHitDotProduct(const EnemyCar& enemy) const {
+    Vector3 playerFacingVector = { playerVehicle.facingX, 0.0f, playerVehicle.facingZ };
+    Vector3 enemyCarToJeepVector = { player.position.x - enemy.position.x,
+                                     player.position.y - enemy.position.y,
+                                     player.position.z - enemy.position.z };
+    return calculateDotProduct(playerFacingVector, enemyCarToJeepVector);
+}
+
+// The impact point is taken as the midpoint between the player and whatever it hit
+void GameWorld::AddEvent(GameEventType type, int index, int scoreChange, int healthChange, const Vector3& other) {
+    Vector3 impactPoint = { (player.position.x + other.x) * 0.5f,
+                            (player.position.y + other.y) * 0.5f,
+                            (player.position.z + other.z) * 0.5f };
+    events.push_back({ type, index, scoreChange, healthChange, score, playerHealth, dotProduct, elapsedTime, impactPoint });
+}
+
+void GameWorld::ResolveTreeContacts() {
+    for (int i = 0; i < int(trees.size()); i++) {
+        if (resolveCircleContact(vehicleParameters, playerVehicle, trees[i], settings.treeRadius)) {
+            // A tree touched in several steps of the same frame only counts once
+            if (std::find(treeContacts.begin(), treeContacts.end(), i) == treeContacts.end()) {
+                treeContacts.push_back(i);
+            }
+        }
+    }
+}
+
+void GameWorld::ResolveEnemyContacts() {
+    for (int i = 0; i < numStaticEnemies; i++) {
+        const EnemyCar& enemy = staticEnemies[i];
+        if (resolveBoxContact(vehicleParameters, playerVehicle, enemy.position, settings.enemyStaticCar, enemy.velocity)) {
+            staticEnemyContacts[i] = true;
+        }
+    }
+
+    // A moving car hands its velocity to the impulse, so one driving into the player shoves it along
+    for (int i = 0; i < numMovingEnemies; i++) {
+        const EnemyCar& enemy = movingEnemies[i];
+        if (resolveBoxContact(vehicleParameters, playerVehicle, enemy.position, movingCarBox, enemy.velocity)) {
+            movingEnemyContacts[i] = true;
+        }
+    }
+}
+
+void GameWorld::ApplyContacts() {
+    for (int i : treeContacts) {
+        playerHealth -= 1;
+        AddEvent(EVENT_TREE_HIT, i, 0, -1, trees[i]);
+    }
+
+    for (int i = 0; i < numStaticEnemies; i++) {
+        if (staticEnemyContacts[i] == false) {
+            continue;
+        }
+        EnemyCar& enemy = staticEnemies[i];
+        dotProduct = CalculateHitDotProduct(enemy);
+
+        int scoreChange = 0;
+        if (enemy.carHitStatus == false) {
+            if (dotProduct > -settings.sideCollisionChecker) {
+                scoreChange = settings.scoreIncreaseForFrontCollision;
+                enemy.carSideHit = true;
+                enemy.carHitStatus = true;
+            }
+            else if (dotProduct < -settings.sideCollisionChecker) {
+                scoreChange = settings.scoreIncreaseForSideCollision;
+                enemy.carSideHit = false;
+                enemy.carHitStatus = true;
+            }
+        }
+        score += scoreChange;
+        AddEvent(EVENT_STATIC_CAR_HIT, i, scoreChange, 0, enemy.position);
+    }
+
+    for (int i = 0; i < numMovingEnemies; i++) {
+        if (movingEnemyContacts[i] == false) {
+            continue;
+        }
+        EnemyCar& enemy = movingEnemies[i];
+        dotProduct = CalculateHitDotProduct(enemy);
+
+        int scoreChange = 0;
+        if (enemy.carHitStatus == false) {
+            if (dotProduct < -settings.sideCollisionChecker) {
+                scoreChange = settings.scoreIncreaseForSideCollision;
+            }
+            else if (dotProduct > -settings.sideCollisionChecker) {
+                scoreChange = settings.scoreIncreaseForFrontCollision;
+            }
+
+            if (scoreChange != 0) {
+                enemy.carHitStatus = true;
+                enemy.carMovementStatus = false;
+                enemy.velocity = { 0, 0, 0 };
+                enemy.resetCarTime = settings.resetCarTimeDefault;
+            }
+        }
+        score += scoreChange;
+        AddEvent(EVENT_MOVING_CAR_HIT, i, scoreChange, 0, enemy.position);
+    }
+}
+
+void GameWorld::UpdateMovingEnemies(float frameTime) {
+    for (int i = 0; i < numMovingEnemies; i++) {
+        EnemyCar& enemy = movingEnemies[i];
+
+        // Cars 1 and 4 move together, as do cars 2 and 3, turning round at the edge of their range
+        if (enemy.carMovementStatus == true) {
+            bool& moveOpposite = (i == 0 || i == 3) ? moveOppositeCar1 : moveOppositeCar2;
+
+            enemy.velocity = { 0, 0, 0 };
+            if (moveOpposite == false) {
+                if (enemy.position.x <= settings.movingCarRange) {
+                    enemy.velocity.x = settings.carMovementSpeed;
+                }
+                else {
+                    moveOpposite = true;
+                }
+            }
+            else {
+                if (enemy.position.x >= -settings.movingCarRange) {
+                    enemy.velocity.x = -settings.carMovementSpeed;
+                }
+                else {
+                    moveOpposite = false;
+                }
+            }
+            enemy.position.x += enemy.velocity.x * frameTime;
+        }
+
+        // The spheres bob up and down together
+        if (enemy.sphereMovementStatus == true) {
+            if (moveOppositeSphere == false) {
+                if (enemy.sphereHeight <= settings.sphereMovingMaxRange) {
+                    enemy.sphereHeight += enemy.sphereMovementSpeed * frameTime;
+                }
+                else {
+                    moveOppositeSphere = true;
+                }
+            }
+            else {
+                if (enemy.sphereHeight >= settings.sphereMovingMinRange) {
+                    enemy.sphereHeight -= enemy.sphereMovementSpeed * frameTime;
+                }
+                else {
+                    moveOppositeSphere = false;
+                }
+            }
+        }
+
+        // A hit car slows its sphere to a stop, then starts moving again and takes back the points it gave
+        if (enemy.carMovementStatus == false) {
+            enemy.resetCarTime += frameTime;
+            enemy.sphereMovementSpeed -= settings.sphereMovementSpeedDecrease * frameTime;
+
+            if (enemy.resetCarTime >= settings.resetCarTimeThreshold1) {
+                enemy.sphereMovementStatus = false;
+                enemy.sphereMovementSpeed = settings.sphereMovementSpeedDefault;
+            }
+
+            if (enemy.resetCarTime >= settings.resetCarTimeThreshold2) {
+                enemy.carMovementStatus = true;
+                enemy.sphereMovementStatus = true;
+                enemy.carHitStatus = false;
+
+                int scoreChange = 0;
+                if (dotProduct < -settings.sideCollisionChecker) {
+                    scoreChange = -settings.scoreIncreaseForSideCollision;
+                }
+                else if (dotProduct > -settings.sideCollisionChecker) {
+                    scoreChange = -settings.scoreIncreaseForFrontCollision;
+                }
+                score += scoreChange;
+                AddEvent(EVENT_MOVING_CAR_RESET, i, scoreChange, 0, enemy.position);
+            }
+        }
+    }
+}
+
+void GameWorld::UpdateWinCondition() {
+    bool movingCarsHit = true;
+    for (int i = 0; i < numMovingEnemies; i++) {
+        if (movingEnemies[i].carMovementStatus == true) {
+            movingCarsHit = false;
+        }
+    }
+    if (movingCarsHit) {
+        allMovingCarsHit = true;
+    }
+
+    bool staticCarsHit = true;
+    for (int i = 0; i < numStaticEnemies; i++) {
+        if (staticEnemies[i].carHitStatus == false) {
+            staticCarsHit = false;
+        }
+    }
+    if (staticCarsHit) {
+        allStaticCarsHit = true;
+    }
+}
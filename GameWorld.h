@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vector>
+
+#include "GameMath.h"
+#include "GameTuning.h"
+#include "VehicleDynamics.h"
+
+const int numStaticEnemies = 4;
+const int numMovingEnemies = 4;
+
+// Tuning values from the table in GameTuning.h, plain members normally and compile time constants when baked
+#ifdef GAME_TUNING_BAKED
+#define DECLARE_TUNING_PARAMETER(type, name, value, minValue, maxValue) static constexpr type name = value;
+#else
+#define DECLARE_TUNING_PARAMETER(type, name, value, minValue, maxValue) type name = value;
+#endif
+
+// Gameplay settings used by the world simulation
+struct GameSettings {
+    GAME_TUNING_PARAMETERS(DECLARE_TUNING_PARAMETER)
+
+    // Collision boxes measured from the car meshes, not tuning values
+    BoundingBox enemyMovingCar = { -1.05776f, 1.05776f, -2.86102e-006f, 1.61014f, -2.13928f, 2.13928f };
+    BoundingBox enemyStaticCar = { -0.946118f, 0.946118f, -0.0065695f, 1.50131f, -1.97237f, 1.97237f };
+};
+
+#undef DECLARE_TUNING_PARAMETER
+
+// Handling of the player's car taken from the gameplay settings
+VehicleParameters makeVehicleParameters(const GameSettings& settings);
+
+// Keys held by the player this frame
+struct DriveInput {
+    bool forward;
+    bool backward;
+    bool left;
+    bool right;
+};
+
+// State of the player's car, copied from its vehicle dynamics after each step
+struct PlayerCar {
+    Vector3 position;
+    float rotationY;
+    float forwardSpeed;
+    float currentWheelRotation;
+    bool turningLeft;
+    bool turningRight;
+};
+
+// State of an enemy car and the sphere attached on top of it
+struct EnemyCar {
+    Vector3 position;
+    Vector3 velocity;
+    float rotationY;
+    float sphereHeight;
+    float sphereMovementSpeed;
+    float resetCarTime;
+
+    // Flags for car and sphere status
+    bool carHitStatus;
+    bool carSideHit;
+    bool carMovementStatus;
+    bool sphereMovementStatus;
+};
+
+enum GameEventType {
+    EVENT_TREE_HIT,
+    EVENT_STATIC_CAR_HIT,
+    EVENT_MOVING_CAR_HIT,
+    EVENT_MOVING_CAR_RESET
+};
+
+// Something that happened during a step, used to drive effects, sounds and HUD feedback
+struct GameEvent {
+    GameEventType type;
+    int index;              // tree or enemy the event is about
+    int scoreChange;
+    int healthChange;
+    int score;              // score and health after the event
+    int playerHealth;
+    float dotProduct;       // facing vector against enemy-to-player vector, tells front and side hits apart
+    float time;             // time since the last restart
+    Vector3 impactPoint;
+};
+
+// Engine independent game simulation, the game copies its state onto the TL-Engine models every frame
+class GameWorld {
+public:
+    explicit GameWorld(const GameSettings& settings = GameSettings());
+
+    // Run one frame of gameplay, events raised during it are available until the next step
+    void Step(const DriveInput& input, float frameTime);
+
+    // Put everything back the way it was at the start of the game
+    void Restart();
+
+#ifndef GAME_TUNING_BAKED
+    // Use new tuning values from the next step on, call it between steps. The trees are placed when the world
+    // is made, so changes to noOfTrees and perimeterRadius are kept for the next run of the game.
+    void SetSettings(const GameSettings& newSettings);
+#endif
+
+    // Individual parts of a step, public so they can be measured on their own.
+    // UpdateDriving runs the fixed steps of the car, resolving contacts with trees and enemies after each one,
+    // then ApplyContacts turns the contacts made during the frame into score, health and events.
+    void UpdateDriving(const DriveInput& input, float frameTime);
+    void ResolveTreeContacts();
+    void ResolveEnemyContacts();
+    void ApplyContacts();
+    void UpdateMovingEnemies(float frameTime);
+    void UpdateWinCondition();
+
+    const GameSettings& GetSettings() const { return settings; }
+    const PlayerCar& GetPlayer() const { return player; }
+    const VehicleState& GetPlayerVehicle() const { return playerVehicle; }
+    const EnemyCar& GetStaticEnemy(int i) const { return staticEnemies[i]; }
+    const EnemyCar& GetMovingEnemy(int i) const { return movingEnemies[i]; }
+    const std::vector<Vector3>& GetTrees() const { return trees; }
+    const std::vector<GameEvent>& GetEvents() const { return events; }
+
+    int GetScore() const { return score; }
+    int GetPlayerHealth() const { return playerHealth; }
+    float GetElapsedTime() const { return elapsedTime; }
+    bool IsGameOver() const { return (allStaticCarsHit == true && allMovingCarsHit == true) || playerHealth < 1; }
+    bool HasWon() const { return allStaticCarsHit == true && allMovingCarsHit == true; }
+
+    // Wheel animation produced by the last step
+    float GetWheelSpinAngle() const { return wheelSpinAngle; }
+    float GetWheelSteerChange() const { return wheelSteerChange; }
+
+private:
+    void SyncPlayer();
+    float CalculateHitDotProduct(const EnemyCar& enemy) const;
+    void AddEvent(GameEventType type, int index, int scoreChange, int healthChange, const Vector3& other);
+
+    GameSettings settings;
+
+    PlayerCar player;
+    VehicleParameters vehicleParameters;
+    VehicleState playerVehicle;
+    FixedStepper physicsStepper;
+    BoundingBox movingCarBox;
+    EnemyCar staticEnemies[numStaticEnemies];
+    EnemyCar movingEnemies[numMovingEnemies];
+    std::vector<Vector3> trees;
+    std::vector<GameEvent> events;
+
+    // Trees and enemies touched during the current frame
+    std::vector<int> treeContacts;
+    bool staticEnemyContacts[numStaticEnemies];
+    bool movingEnemyContacts[numMovingEnemies];
+
+    int score;
+    int playerHealth;
+    float dotProduct;
+    float elapsedTime;
+
+    bool moveOppositeCar1;
+    bool moveOppositeCar2;
+    bool moveOppositeSphere;
+    bool allStaticCarsHit;
+    bool allMovingCarsHit;
+
+    float wheelSpinAngle;
+    float wheelSteerChange;
+};
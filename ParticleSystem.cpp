@@ -0,0 +1,298 @@
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <numeric>
+
+#ifdef GAME_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// Allocate a float array aligned for 16 byte SIMD loads and stores
+static float* AllocateFloats(int count) {
+#ifdef GAME_USE_SSE
+    return static_cast<float*>(_mm_malloc(count * sizeof(float), 16));
+#else
+    return new float[count];
+#endif
+}
+
+static void FreeFloats(float* data) {
+#ifdef GAME_USE_SSE
+    _mm_free(data);
+#else
+    delete[] data;
+#endif
+}
+
+ParticlePool::ParticlePool(const ParticlePoolSettings& settings)
+    : settings(settings),
+      paddedCapacity((settings.capacity + 3) & ~3) {
+
+    float** arrays[] = { &posX, &posY, &posZ, &velX, &velY, &velZ, &life };
+    for (float** array : arrays) {
+        *array = AllocateFloats(paddedCapacity);
+        std::fill(*array, *array + paddedCapacity, 0.0f);
+    }
+
+    drawDistances.reserve(settings.capacity);
+    drawOrder.reserve(settings.capacity);
+    drawPositions.reserve(settings.maxDrawn);
+}
+
+ParticlePool::~ParticlePool() {
+    float* arrays[] = { posX, posY, posZ, velX, velY, velZ, life };
+    for (float* array : arrays) {
+        FreeFloats(array);
+    }
+}
+
+bool ParticlePool::Spawn(const Vector3& position, const Vector3& velocity, float lifetime) {
+    if (liveCount >= settings.capacity) {
+        return false;
+    }
+
+    posX[liveCount] = position.x;
+    posY[liveCount] = position.y;
+    posZ[liveCount] = position.z;
+    velX[liveCount] = velocity.x;
+    velY[liveCount] = velocity.y;
+    velZ[liveCount] = velocity.z;
+    life[liveCount] = lifetime;
+    liveCount++;
+
+    return true;
+}
+
+void ParticlePool::Update(float frameTime) {
+    const float gravityStep = settings.gravity * frameTime;
+    const float dragFactor = std::max(0.0f, 1.0f - settings.drag * frameTime);
+
+    // Lanes past liveCount hold stale data inside the padded capacity, updating them is harmless
+    const int count = (liveCount + 3) & ~3;
+
+#ifdef GAME_USE_SSE
+    const __m128 dt = _mm_set1_ps(frameTime);
+    const __m128 gravity = _mm_set1_ps(gravityStep);
+    const __m128 drag = _mm_set1_ps(dragFactor);
+    const __m128 bounce = _mm_set1_ps(-settings.restitution);
+    const __m128 floorY = _mm_set1_ps(settings.floorY);
+
+    for (int i = 0; i < count; i += 4) {
+        __m128 vx = _mm_mul_ps(_mm_load_ps(velX + i), drag);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(velY + i), gravity), drag);
+        __m128 vz = _mm_mul_ps(_mm_load_ps(velZ + i), drag);
+
+        __m128 x = _mm_add_ps(_mm_load_ps(posX + i), _mm_mul_ps(vx, dt));
+        __m128 y = _mm_add_ps(_mm_load_ps(posY + i), _mm_mul_ps(vy, dt));
+        __m128 z = _mm_add_ps(_mm_load_ps(posZ + i), _mm_mul_ps(vz, dt));
+
+        // Bounce particles that fell through the floor back up with reduced speed
+        __m128 belowFloor = _mm_cmplt_ps(y, floorY);
+        y = _mm_max_ps(y, floorY);
+        vy = _mm_or_ps(_mm_and_ps(belowFloor, _mm_mul_ps(vy, bounce)), _mm_andnot_ps(belowFloor, vy));
+
+        _mm_store_ps(posX + i, x);
+        _mm_store_ps(posY + i, y);
+        _mm_store_ps(posZ + i, z);
+        _mm_store_ps(velX + i, vx);
+        _mm_store_ps(velY + i, vy);
+        _mm_store_ps(velZ + i, vz);
+        _mm_store_ps(life + i, _mm_sub_ps(_mm_load_ps(life + i), dt));
+    }
+#else
+    for (int i = 0; i < count; i++) {
+        velX[i] *= dragFactor;
+        velY[i] = (velY[i] + gravityStep) * dragFactor;
+        velZ[i] *= dragFactor;
+
+        posX[i] += velX[i] * frameTime;
+        posY[i] += velY[i] * frameTime;
+        posZ[i] += velZ[i] * frameTime;
+
+        if (posY[i] < settings.floorY) {
+            posY[i] = settings.floorY;
+            velY[i] *= -settings.restitution;
+        }
+
+        life[i] -= frameTime;
+    }
+#endif
+
+    RemoveDeadParticles();
+}
+
+void ParticlePool::RemoveDeadParticles() {
+    int i = 0;
+    while (i < liveCount) {
+
+#ifdef GAME_USE_SSE
+        // Skip whole groups of four when none of them have died
+        if (i + 4 <= liveCount && _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(life + i), _mm_setzero_ps())) == 0) {
+            i += 4;
+            continue;
+        }
+#endif
+
+        if (life[i] > 0.0f) {
+            i++;
+            continue;
+        }
+
+        // Swap the last live particle into the dead slot, then check the same slot again
+        liveCount--;
+        posX[i] = posX[liveCount];
+        posY[i] = posY[liveCount];
+        posZ[i] = posZ[liveCount];
+        velX[i] = velX[liveCount];
+        velY[i] = velY[liveCount];
+        velZ[i] = velZ[liveCount];
+        life[i] = life[liveCount];
+    }
+}
+
+int ParticlePool::BuildDrawList(const Vector3& cameraPosition) {
+    drawDistances.resize(liveCount);
+    drawOrder.resize(liveCount);
+
+    for (int i = 0; i < liveCount; i++) {
+        float dx = posX[i] - cameraPosition.x;
+        float dy = posY[i] - cameraPosition.y;
+        float dz = posZ[i] - cameraPosition.z;
+        drawDistances[i] = dx * dx + dy * dy + dz * dz;
+    }
+    std::iota(drawOrder.begin(), drawOrder.end(), 0);
+
+    auto nearer = [this](int a, int b) { return drawDistances[a] < drawDistances[b]; };
+    auto further = [this](int a, int b) { return drawDistances[a] > drawDistances[b]; };
+
+    // Only the nearest particles are drawn when there are more than the draw budget allows
+    int drawCount = std::min(liveCount, settings.maxDrawn);
+    if (drawCount < liveCount) {
+        std::nth_element(drawOrder.begin(), drawOrder.begin() + drawCount, drawOrder.end(), nearer);
+    }
+    std::sort(drawOrder.begin(), drawOrder.begin() + drawCount, further);
+
+    drawPositions.resize(drawCount);
+    for (int i = 0; i < drawCount; i++) {
+        int index = drawOrder[i];
+        drawPositions[i] = { posX[index], posY[index], posZ[index] };
+    }
+
+    return drawCount;
+}
+
+void ParticlePool::Clear() {
+    liveCount = 0;
+    drawPositions.clear();
+}
+
+void ParticlePool::SetSettings(const ParticlePoolSettings& newSettings) {
+    const int capacity = settings.capacity;
+    const int maxDrawn = settings.maxDrawn;
+
+    settings = newSettings;
+    settings.capacity = capacity;
+    settings.maxDrawn = maxDrawn;
+}
+
+ParticleSystem::ParticleSystem(const ParticlePoolSettings poolSettings[NUM_PARTICLE_KINDS], int maxEmitters)
+    : emitters(maxEmitters) {
+
+    for (int i = 0; i < NUM_PARTICLE_KINDS; i++) {
+        pools[i].reset(new ParticlePool(poolSettings[i]));
+        batches[i] = { static_cast<ParticleKind>(i), nullptr, 0 };
+    }
+
+    for (Emitter& emitter : emitters) {
+        emitter.active = false;
+    }
+}
+
+bool ParticleSystem::StartEmitter(const EmitterSettings& emitterSettings, const Vector3& position) {
+    for (Emitter& emitter : emitters) {
+        if (emitter.active == false) {
+            emitter.settings = emitterSettings;
+            emitter.position = position;
+            emitter.timeLeft = emitterSettings.duration;
+            emitter.spawnAccumulator = 0.0f;
+            emitter.active = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Cheap xorshift generator returning a value between -1 and 1, keeps spawning free of locks and allocation
+float ParticleSystem::RandomFloat() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState & 0xFFFFFF) / float(0x800000) - 1.0f;
+}
+
+void ParticleSystem::RunEmitter(Emitter& emitter, float frameTime) {
+    const EmitterSettings& settings = emitter.settings;
+    ParticlePool& pool = *pools[settings.kind];
+
+    // Only count the part of the frame the emitter was still running for
+    float activeTime = std::min(frameTime, emitter.timeLeft);
+    emitter.spawnAccumulator += settings.rate * activeTime;
+    emitter.timeLeft -= frameTime;
+
+    while (emitter.spawnAccumulator >= 1.0f) {
+        emitter.spawnAccumulator -= 1.0f;
+
+        Vector3 direction = { RandomFloat(), RandomFloat(), RandomFloat() };
+        Vector3 velocity = { direction.x * settings.spread * settings.speed,
+                             (direction.y * settings.spread + settings.upwardBias) * settings.speed,
+                             direction.z * settings.spread * settings.speed };
+        float lifetime = settings.lifetime * (0.75f + 0.25f * RandomFloat());
+
+        if (pool.Spawn(emitter.position, velocity, lifetime) == false) {
+            emitter.spawnAccumulator = 0.0f;
+            break;
+        }
+    }
+
+    if (emitter.timeLeft <= 0.0f) {
+        emitter.active = false;
+    }
+}
+
+void ParticleSystem::Update(float frameTime) {
+    for (Emitter& emitter : emitters) {
+        if (emitter.active == true) {
+            RunEmitter(emitter, frameTime);
+        }
+    }
+
+    for (int i = 0; i < NUM_PARTICLE_KINDS; i++) {
+        pools[i]->Update(frameTime);
+    }
+}
+
+const ParticleDrawBatch* ParticleSystem::BuildDrawBatches(const Vector3& cameraPosition) {
+    for (int i = 0; i < NUM_PARTICLE_KINDS; i++) {
+        batches[i].count = pools[i]->BuildDrawList(cameraPosition);
+        batches[i].positions = pools[i]->GetDrawPositions();
+    }
+    return batches;
+}
+
+void ParticleSystem::Clear() {
+    for (Emitter& emitter : emitters) {
+        emitter.active = false;
+    }
+
+    for (int i = 0; i < NUM_PARTICLE_KINDS; i++) {
+        pools[i]->Clear();
+    }
+}
+
+int ParticleSystem::GetLiveCount() const {
+    int total = 0;
+    for (int i = 0; i < NUM_PARTICLE_KINDS; i++) {
+        total += pools[i]->GetLiveCount();
+    }
+    return total;
+}
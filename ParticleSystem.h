@@ -0,0 +1,127 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "GameMath.h"
+
+// Kinds of particle, each kept in its own pool and drawn with its own mesh so batches never mix materials
+enum ParticleKind {
+    PARTICLE_SPARK,
+    PARTICLE_DEBRIS,
+    NUM_PARTICLE_KINDS
+};
+
+// Budget and physical behaviour of one particle pool
+struct ParticlePoolSettings {
+    int capacity;           // maximum number of live particles
+    int maxDrawn;           // maximum number of particles submitted for drawing each frame
+    float gravity;          // vertical acceleration applied every update
+    float drag;             // fraction of velocity lost per second
+    float restitution;      // fraction of vertical speed kept when bouncing off the floor
+    float floorY;           // height of the floor particles bounce on
+};
+
+// Settings describing how an emitter sprays particles into a pool
+struct EmitterSettings {
+    ParticleKind kind;
+    float duration;         // seconds the emitter keeps spawning particles
+    float rate;             // particles spawned per second
+    float speed;            // initial speed of each particle
+    float spread;           // random variation added to the direction of each particle
+    float upwardBias;       // extra vertical speed so particles spray up rather than into the ground
+    float lifetime;         // seconds each particle lives for
+};
+
+// A group of particles of the same kind, sorted back to front, ready to be drawn
+struct ParticleDrawBatch {
+    ParticleKind kind;
+    const Vector3* positions;
+    int count;
+};
+
+// Pool of particles stored as structure-of-arrays so the update can run four particles at a time
+class ParticlePool {
+public:
+    explicit ParticlePool(const ParticlePoolSettings& settings);
+    ~ParticlePool();
+
+    ParticlePool(const ParticlePool&) = delete;
+    ParticlePool& operator=(const ParticlePool&) = delete;
+
+    // Add a particle, returns false when the pool is already at its capacity
+    bool Spawn(const Vector3& position, const Vector3& velocity, float lifetime);
+
+    // Integrate position, velocity and lifetime of every live particle and remove the dead ones
+    void Update(float frameTime);
+
+    // Pick the particles nearest the camera (up to maxDrawn) and sort them back to front
+    int BuildDrawList(const Vector3& cameraPosition);
+
+    void Clear();
+
+    // Change how the particles move, the capacity and draw budget stay as the pool was made with
+    void SetSettings(const ParticlePoolSettings& newSettings);
+
+    int GetLiveCount() const { return liveCount; }
+    int GetCapacity() const { return settings.capacity; }
+    const Vector3* GetDrawPositions() const { return drawPositions.data(); }
+
+private:
+    void RemoveDeadParticles();
+
+    ParticlePoolSettings settings;
+    int paddedCapacity;
+    int liveCount = 0;
+
+    // Structure-of-arrays particle data, 16 byte aligned and padded to a multiple of four
+    float* posX;
+    float* posY;
+    float* posZ;
+    float* velX;
+    float* velY;
+    float* velZ;
+    float* life;
+
+    // Scratch buffers reused by BuildDrawList so drawing never allocates once warmed up
+    std::vector<float> drawDistances;
+    std::vector<int> drawOrder;
+    std::vector<Vector3> drawPositions;
+};
+
+// Particle system owning one pool per particle kind and a fixed pool of emitters
+class ParticleSystem {
+public:
+    ParticleSystem(const ParticlePoolSettings poolSettings[NUM_PARTICLE_KINDS], int maxEmitters);
+
+    // Start an emitter at the given position, returns false when every emitter is busy
+    bool StartEmitter(const EmitterSettings& emitterSettings, const Vector3& position);
+
+    // Run the active emitters and then update every pool
+    void Update(float frameTime);
+
+    // Build one draw batch per particle kind, the returned array has NUM_PARTICLE_KINDS entries
+    const ParticleDrawBatch* BuildDrawBatches(const Vector3& cameraPosition);
+
+    void Clear();
+
+    int GetLiveCount() const;
+    ParticlePool& GetPool(ParticleKind kind) { return *pools[kind]; }
+
+private:
+    struct Emitter {
+        EmitterSettings settings;
+        Vector3 position;
+        float timeLeft;
+        float spawnAccumulator;
+        bool active;
+    };
+
+    float RandomFloat();
+    void RunEmitter(Emitter& emitter, float frameTime);
+
+    std::unique_ptr<ParticlePool> pools[NUM_PARTICLE_KINDS];
+    std::vector<Emitter> emitters;
+    ParticleDrawBatch batches[NUM_PARTICLE_KINDS];
+    unsigned int randomState = 0x9E3779B9u;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Lock-free queue for exactly one producer thread and one consumer thread. The storage is allocated once up
+// front, so pushing and popping never allocate, block or make system calls.
+template <typename T>
+class SpscQueue {
+public:
+    // Capacity is rounded up to a power of two so wrapping round is a mask rather than a division
+    explicit SpscQueue(size_t minimumCapacity)
+        : slots(roundUpToPowerOfTwo(minimumCapacity)),
+          mask(slots.size() - 1) {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only, returns false and drops the item when the queue is full
+    bool TryPush(const T& item) {
+        const size_t head = writeIndex.load(std::memory_order_relaxed);
+        if (head - cachedReadIndex == slots.size()) {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            if (head - cachedReadIndex == slots.size()) {
+                return false;
+            }
+        }
+
+        slots[head & mask] = item;
+        writeIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only, returns false when there is nothing to read
+    bool TryPop(T& item) {
+        const size_t tail = readIndex.load(std::memory_order_relaxed);
+        if (tail == cachedWriteIndex) {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+            if (tail == cachedWriteIndex) {
+                return false;
+            }
+        }
+
+        item = slots[tail & mask];
+        readIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only exact when called from one of the two threads while the other is idle
+    size_t GetSize() const { return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire); }
+    size_t GetCapacity() const { return slots.size(); }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t capacity = 1;
+        while (capacity < value) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    std::vector<T> slots;
+    const size_t mask;
+
+    // Each side's index and its cached copy of the other side's index share a cache line, kept apart from the
+    // other side so the two threads do not fight over it
+    alignas(64) std::atomic<size_t> writeIndex{ 0 };
+    size_t cachedReadIndex = 0;
+    alignas(64) std::atomic<size_t> readIndex{ 0 };
+    size_t cachedWriteIndex = 0;
+};
@@ -0,0 +1,228 @@
+#include "Telemetry.h"
+
+#include <chrono>
+#include <cstring>
+
+static const char logMagic[4] = { 'C', 'G', 'T', 'L' };
+static const uint32_t logVersion = 1;
+
+// Events gathered into one columnar block, and how long a part filled block may wait before it is written
+static const size_t eventsPerBlock = 1024;
+static const std::chrono::milliseconds flushInterval(250);
+static const std::chrono::milliseconds idleSleep(2);
+
+// Bytes one event takes up across the columns of a block
+static const size_t eventBytes = sizeof(float) * 2 + sizeof(int32_t) + sizeof(int16_t) * 4 + sizeof(uint8_t) * 2;
+
+TelemetryEvent makeTelemetryEvent(const GameEvent& event, float sideCollisionChecker) {
+    TelemetryEvent telemetryEvent;
+    telemetryEvent.time = event.time;
+    telemetryEvent.dotProduct = event.dotProduct;
+    telemetryEvent.score = event.score;
+    telemetryEvent.index = int16_t(event.index);
+    telemetryEvent.scoreChange = int16_t(event.scoreChange);
+    telemetryEvent.playerHealth = int16_t(event.playerHealth);
+    telemetryEvent.healthChange = int16_t(event.healthChange);
+    telemetryEvent.hitSide = HIT_NONE;
+
+    switch (event.type) {
+    case EVENT_TREE_HIT:
+        telemetryEvent.type = TELEMETRY_TREE_HIT;
+        break;
+    case EVENT_STATIC_CAR_HIT:
+        telemetryEvent.type = TELEMETRY_STATIC_CAR_HIT;
+        break;
+    case EVENT_MOVING_CAR_HIT:
+        telemetryEvent.type = TELEMETRY_MOVING_CAR_HIT;
+        break;
+    case EVENT_MOVING_CAR_RESET:
+        telemetryEvent.type = TELEMETRY_MOVING_CAR_RESET;
+        break;
+    }
+
+    // Same test the world uses to score a hit, exactly on the boundary counts as neither
+    if (event.type != EVENT_TREE_HIT) {
+        if (event.dotProduct > -sideCollisionChecker) {
+            telemetryEvent.hitSide = HIT_FRONT;
+        }
+        else if (event.dotProduct < -sideCollisionChecker) {
+            telemetryEvent.hitSide = HIT_SIDE;
+        }
+    }
+
+    return telemetryEvent;
+}
+
+TelemetryEvent makeTelemetryEvent(TelemetryEventType type, const GameWorld& world) {
+    TelemetryEvent telemetryEvent;
+    telemetryEvent.time = world.GetElapsedTime();
+    telemetryEvent.dotProduct = 0.0f;
+    telemetryEvent.score = world.GetScore();
+    telemetryEvent.index = -1;
+    telemetryEvent.scoreChange = 0;
+    telemetryEvent.playerHealth = int16_t(world.GetPlayerHealth());
+    telemetryEvent.healthChange = 0;
+    telemetryEvent.type = type;
+    telemetryEvent.hitSide = HIT_NONE;
+    return telemetryEvent;
+}
+
+Telemetry::Telemetry(size_t queueCapacity)
+    : queue(queueCapacity) {
+    block.reserve(eventsPerBlock);
+    blockBytes.reserve(sizeof(uint32_t) + eventsPerBlock * sizeof(TelemetryEvent));
+}
+
+Telemetry::~Telemetry() {
+    Stop();
+}
+
+bool Telemetry::Start(const std::string& logPath) {
+    if (IsRunning()) {
+        return true;
+    }
+
+    log.open(logPath, std::ios::binary | std::ios::trunc);
+    if (!log) {
+        return false;
+    }
+
+    log.write(logMagic, sizeof(logMagic));
+    log.write(reinterpret_cast<const char*>(&logVersion), sizeof(logVersion));
+
+    running.store(true);
+    writer = std::thread(&Telemetry::WriterLoop, this);
+    return true;
+}
+
+void Telemetry::Stop() {
+    if (!IsRunning()) {
+        return;
+    }
+
+    running.store(false);
+    writer.join();
+    log.close();
+}
+
+void Telemetry::WriterLoop() {
+    auto lastWrite = std::chrono::steady_clock::now();
+
+    while (true) {
+        // Read the flag before draining so nothing pushed before Stop is left behind
+        bool stopping = !running.load();
+
+        TelemetryEvent event;
+        while (queue.TryPop(event)) {
+            block.push_back(event);
+            if (block.size() == eventsPerBlock) {
+                WriteBlock();
+                lastWrite = std::chrono::steady_clock::now();
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!block.empty() && (stopping || now - lastWrite >= flushInterval)) {
+            WriteBlock();
+            log.flush();
+            lastWrite = now;
+        }
+
+        if (stopping) {
+            break;
+        }
+
+        std::this_thread::sleep_for(idleSleep);
+    }
+}
+
+// Append one column to the block bytes, reading the field at the given offset of every event
+template <typename Field>
+static void appendColumn(std::vector<char>& bytes, const std::vector<TelemetryEvent>& events, Field TelemetryEvent::* field) {
+    for (const TelemetryEvent& event : events) {
+        const char* value = reinterpret_cast<const char*>(&(event.*field));
+        bytes.insert(bytes.end(), value, value + sizeof(Field));
+    }
+}
+
+void Telemetry::WriteBlock() {
+    uint32_t count = uint32_t(block.size());
+
+    blockBytes.clear();
+    const char* countBytes = reinterpret_cast<const char*>(&count);
+    blockBytes.insert(blockBytes.end(), countBytes, countBytes + sizeof(count));
+
+    appendColumn(blockBytes, block, &TelemetryEvent::time);
+    appendColumn(blockBytes, block, &TelemetryEvent::dotProduct);
+    appendColumn(blockBytes, block, &TelemetryEvent::score);
+    appendColumn(blockBytes, block, &TelemetryEvent::index);
+    appendColumn(blockBytes, block, &TelemetryEvent::scoreChange);
+    appendColumn(blockBytes, block, &TelemetryEvent::playerHealth);
+    appendColumn(blockBytes, block, &TelemetryEvent::healthChange);
+    appendColumn(blockBytes, block, &TelemetryEvent::type);
+    appendColumn(blockBytes, block, &TelemetryEvent::hitSide);
+
+    log.write(blockBytes.data(), blockBytes.size());
+    writtenEvents.fetch_add(count, std::memory_order_relaxed);
+    block.clear();
+}
+
+// Read one column of a block back into the events
+template <typename Field>
+static bool readColumn(std::ifstream& file, TelemetryEvent* events, uint32_t count, Field TelemetryEvent::* field) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (!file.read(reinterpret_cast<char*>(&(events[i].*field)), sizeof(Field))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readTelemetryLog(const std::string& logPath, std::vector<TelemetryEvent>& events) {
+    std::ifstream file(logPath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    char magic[sizeof(logMagic)];
+    uint32_t version;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, logMagic, sizeof(magic)) != 0 ||
+        !file.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != logVersion) {
+        return false;
+    }
+
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    file.seekg(sizeof(logMagic) + sizeof(logVersion));
+
+    uint32_t count;
+    while (file.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+        // The writer never puts more than a block's worth of events in a block, a bigger count or one the rest
+        // of the file cannot hold is a tail cut short or overwritten by a crash, so reading stops there
+        std::streamoff bytesLeft = fileSize - file.tellg();
+        if (count > eventsPerBlock || std::streamoff(count * eventBytes) > bytesLeft) {
+            break;
+        }
+
+        size_t first = events.size();
+        events.resize(first + count);
+        TelemetryEvent* blockEvents = events.data() + first;
+
+        // A block cut short by a crash is dropped rather than read half filled
+        bool complete = readColumn(file, blockEvents, count, &TelemetryEvent::time) &&
+                        readColumn(file, blockEvents, count, &TelemetryEvent::dotProduct) &&
+                        readColumn(file, blockEvents, count, &TelemetryEvent::score) &&
+                        readColumn(file, blockEvents, count, &TelemetryEvent::index) &&
+                        readColumn(file, blockEvents, count, &TelemetryEvent::scoreChange) &&
+                        readColumn(file, blockEvents, count, &TelemetryEvent::playerHealth) &&
+                        readColumn(file, blockEvents, count, &TelemetryEvent::healthChange) &&
+                        readColumn(file, blockEvents, count, &TelemetryEvent::type) &&
+                        readColumn(file, blockEvents, count, &TelemetryEvent::hitSide);
+        if (!complete) {
+            events.resize(first);
+            break;
+        }
+    }
+
+    return true;
+}
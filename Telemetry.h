@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GameWorld.h"
+#include "SpscQueue.h"
+
+enum TelemetryEventType : uint8_t {
+    TELEMETRY_TREE_HIT,
+    TELEMETRY_STATIC_CAR_HIT,
+    TELEMETRY_MOVING_CAR_HIT,
+    TELEMETRY_MOVING_CAR_RESET,
+    TELEMETRY_GAME_OVER,
+    TELEMETRY_GAME_RESTART,
+    NUM_TELEMETRY_EVENT_TYPES
+};
+
+// Which way round the player hit an enemy, from the facing vector against enemy-to-player vector test
+enum TelemetryHitSide : uint8_t {
+    HIT_NONE,
+    HIT_FRONT,
+    HIT_SIDE
+};
+
+// One gameplay event, small and trivially copyable so it can go through the queue by value
+struct TelemetryEvent {
+    float time;             // seconds since the last restart
+    float dotProduct;
+    int32_t score;          // score after the event
+    int16_t index;          // tree or enemy the event is about, -1 when it is about the whole game
+    int16_t scoreChange;
+    int16_t playerHealth;   // health after the event
+    int16_t healthChange;
+    TelemetryEventType type;
+    TelemetryHitSide hitSide;
+};
+
+// Convert an event raised by the game world into a telemetry event
+TelemetryEvent makeTelemetryEvent(const GameEvent& event, float sideCollisionChecker);
+
+// Telemetry event for something that happened to the whole game, such as game over or restart
+TelemetryEvent makeTelemetryEvent(TelemetryEventType type, const GameWorld& world);
+
+// Gameplay telemetry. The game loop hands events to Emit, which only copies them into a lock-free queue.
+// A background thread drains the queue and writes the events to a columnar binary log.
+//
+// Log format, all values little endian:
+//   file header:  "CGTL" then uint32 version
+//   each block:   uint32 event count n, then one column per field in TelemetryEvent order
+//                 (float time[n], float dotProduct[n], int32 score[n], int16 index[n], int16 scoreChange[n],
+//                  int16 playerHealth[n], int16 healthChange[n], uint8 type[n], uint8 hitSide[n])
+class Telemetry {
+public:
+    explicit Telemetry(size_t queueCapacity = 8192);
+    ~Telemetry();
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    // Open the log and start the writer thread, returns false if the log cannot be created
+    bool Start(const std::string& logPath);
+
+    // Drain whatever is left in the queue, write it out and stop the writer thread
+    void Stop();
+
+    // Called from the game loop, never blocks or allocates. Events are dropped and counted when the queue is full.
+    void Emit(const TelemetryEvent& event) {
+        if (!queue.TryPush(event)) {
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool IsRunning() const { return running.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedEvents() const { return droppedEvents.load(std::memory_order_relaxed); }
+    uint64_t GetWrittenEvents() const { return writtenEvents.load(std::memory_order_relaxed); }
+    size_t GetQueuedEvents() const { return queue.GetSize(); }
+
+private:
+    void WriterLoop();
+    void WriteBlock();
+
+    SpscQueue<TelemetryEvent> queue;
+    std::vector<TelemetryEvent> block;
+    std::vector<char> blockBytes;
+    std::ofstream log;
+    std::thread writer;
+    std::atomic<bool> running{ false };
+    std::atomic<uint64_t> droppedEvents{ 0 };
+    std::atomic<uint64_t> writtenEvents{ 0 };
+};
+
+// Read every event from a telemetry log, returns false if the file is missing or not a telemetry log
+bool readTelemetryLog(const std::string& logPath, std::vector<TelemetryEvent>& events);
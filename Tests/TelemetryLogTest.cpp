@@ -0,0 +1,100 @@
+// Writes events through Telemetry and reads them back with readTelemetryLog, then checks that a log with a
+// corrupt block count or a cut off tail gives back the complete blocks in front of it instead of failing.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../Telemetry.h"
+#include "TestCheck.h"
+
+static const char* logPath = "telemetry_log_test.bin";
+static const char* damagedLogPath = "telemetry_log_test_damaged.bin";
+
+// More than two blocks' worth, so the last block is only part filled
+static const int numEvents = 2500;
+
+static TelemetryEvent makeTestEvent(int i) {
+    TelemetryEvent event;
+    event.time = float(i) * 0.25f;
+    event.dotProduct = float(i % 7) - 3.5f;
+    event.score = i * 10;
+    event.index = int16_t(i % 160);
+    event.scoreChange = int16_t(i % 3 == 0 ? 15 : -10);
+    event.playerHealth = int16_t(100 - i % 100);
+    event.healthChange = int16_t(-(i % 2));
+    event.type = TelemetryEventType(i % NUM_TELEMETRY_EVENT_TYPES);
+    event.hitSide = TelemetryHitSide(i % 3);
+    return event;
+}
+
+static bool sameEvent(const TelemetryEvent& a, const TelemetryEvent& b) {
+    return a.time == b.time && a.dotProduct == b.dotProduct && a.score == b.score && a.index == b.index &&
+           a.scoreChange == b.scoreChange && a.playerHealth == b.playerHealth && a.healthChange == b.healthChange &&
+           a.type == b.type && a.hitSide == b.hitSide;
+}
+
+static std::vector<char> readBytes(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void writeBytes(const char* path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), bytes.size());
+}
+
+int main() {
+    Telemetry telemetry;
+    check(telemetry.Start(logPath), "telemetry log could not be created");
+    for (int i = 0; i < numEvents; i++) {
+        telemetry.Emit(makeTestEvent(i));
+    }
+    telemetry.Stop();
+    check(telemetry.GetDroppedEvents() == 0, "events were dropped");
+
+    std::vector<TelemetryEvent> events;
+    check(readTelemetryLog(logPath, events), "written log could not be read");
+    check(events.size() == numEvents, "wrong number of events read back");
+    for (size_t i = 0; i < events.size() && i < numEvents; i++) {
+        if (!sameEvent(events[i], makeTestEvent(int(i)))) {
+            check(false, "event read back differs from the one written");
+            break;
+        }
+    }
+
+    // The first block is full, so its events end where the second block's count starts
+    const size_t headerBytes = 8;
+    const size_t blockBytes = 4 + 1024 * 22;
+    std::vector<char> log = readBytes(logPath);
+
+    // Garbage count in the second block, only the first block is kept and nothing huge is allocated
+    std::vector<char> damaged = log;
+    std::memset(damaged.data() + headerBytes + blockBytes, 0xff, 4);
+    writeBytes(damagedLogPath, damaged);
+    events.clear();
+    check(readTelemetryLog(damagedLogPath, events), "log with a corrupt count could not be read");
+    check(events.size() == 1024, "corrupt count did not stop reading after the first block");
+
+    // Count larger than one block but smaller than garbage
+    uint32_t tooMany = 1025;
+    std::memcpy(damaged.data() + headerBytes + blockBytes, &tooMany, sizeof(tooMany));
+    writeBytes(damagedLogPath, damaged);
+    events.clear();
+    check(readTelemetryLog(damagedLogPath, events) && events.size() == 1024, "oversized block count was read");
+
+    // Tail cut off part way through the last block
+    damaged.assign(log.begin(), log.end() - 5);
+    writeBytes(damagedLogPath, damaged);
+    events.clear();
+    check(readTelemetryLog(damagedLogPath, events), "log with a cut off tail could not be read");
+    check(events.size() == 2048, "cut off tail did not leave the two full blocks");
+
+    std::remove(logPath);
+    std::remove(damagedLogPath);
+
+    return finishTests("Telemetry log round trip passed");
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+// Failure counting shared by the test programs, each one is a single source file with its own main
+
+#include <cstdio>
+#include <string>
+
+static int failures = 0;
+
+// Report a failed condition and carry on, so one run shows every check that fails
+static void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::printf("FAILED: %s\n", message.c_str());
+        failures++;
+    }
+}
+
+// Print the pass message if nothing failed and give back the exit code for main
+static int finishTests(const char* passedMessage) {
+    if (failures == 0) {
+        std::printf("%s\n", passedMessage);
+    }
+    return failures == 0 ? 0 : 1;
+}
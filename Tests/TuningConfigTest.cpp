@@ -0,0 +1,60 @@
+// Reads tuning config files with good, badly written and out of range values and checks which ones are accepted.
+// A rejected file must leave the settings the game would keep running with usable.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../TuningConfig.h"
+#include "TestCheck.h"
+
+static const char* configPath = "tuning_config_test.cfg";
+
+static bool loadConfig(const std::string& contents, GameSettings& settings, std::string& errors) {
+    {
+        std::ofstream file(configPath, std::ios::trunc);
+        file << contents;
+    }
+    return loadTuningConfig(configPath, settings, errors);
+}
+
+// The whole file is rejected and the error names the line
+static void checkRejected(const std::string& contents, const std::string& expectedError) {
+    GameSettings settings;
+    std::string errors;
+    check(!loadConfig(contents, settings, errors), "accepted: " + contents);
+    check(errors.find(expectedError) != std::string::npos, "no '" + expectedError + "' in: " + errors);
+}
+
+int main() {
+    GameSettings settings;
+    std::string errors;
+    check(loadConfig("# comment\n\nwheelBase = 3.5  # longer car\nmaxPhysicsStepsPerFrame = 4\n", settings, errors),
+          "good file rejected: " + errors);
+    check(settings.wheelBase == 3.5f && settings.maxPhysicsStepsPerFrame == 4, "good values not set");
+    check(settings.acceleration == GameSettings().acceleration, "value not in the file changed");
+
+    // No file leaves every value at its default without reporting anything
+    std::remove(configPath);
+    GameSettings defaults;
+    check(loadTuningConfig(configPath, defaults, errors), "missing file rejected: " + errors);
+    check(errors.empty(), "missing file reported: " + errors);
+    check(defaults.wheelBase == GameSettings().wheelBase, "missing file changed a value");
+
+    checkRejected("wheelBase = 3.0f\n", "bad value '3.0f' for wheelBase");
+    checkRejected("noOfTrees = 1O\n", "bad value '1O' for noOfTrees");
+    checkRejected("wheelBaze = 3\n", "unknown setting wheelBaze");
+    checkRejected("wheelBase 3\n", ":1: expected name = value");
+
+    // Values that parse but would break the simulation, a wheel base or step rate of 0 divides by zero
+    checkRejected("wheelBase = 0\n", "wheelBase = 0 is outside its range of 0.5 to 10");
+    checkRejected("physicsStepRate = 0\n", "physicsStepRate = 0 is outside its range");
+    checkRejected("maxPhysicsStepsPerFrame = -1\n", "maxPhysicsStepsPerFrame = -1 is outside its range of 1 to 64");
+    checkRejected("bounceFactor = nan\n", "bounceFactor = nan is outside its range");
+    checkRejected("acceleration = inf\n", "acceleration = inf is outside its range");
+    checkRejected("acceleration = 30\nwheelBase = 0\n", ":2: wheelBase = 0");
+
+    std::remove(configPath);
+
+    return finishTests("Tuning config checks passed");
+}
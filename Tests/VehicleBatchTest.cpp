@@ -0,0 +1,68 @@
+// Runs the same vehicles through VehicleBatch and through integrateVehicle one at a time and checks they end up
+// exactly the same. The count is not a multiple of four, so both the SIMD loop and the loop for the vehicles
+// left over are covered.
+
+#include <cstdio>
+#include <vector>
+
+#include "../GameWorld.h"
+#include "../VehicleDynamics.h"
+
+static const int numVehicles = 11;
+static const int numFrames = 600;
+
+static VehicleControls makeTestControls(int vehicle, int frame) {
+    // Every vehicle changes what it is doing every couple of seconds, covering forward, reverse and coasting
+    int phase = (vehicle + frame / 120) % 3;
+    float steer = float((vehicle * 7 + frame / 45) % 5 - 2) * 0.5f;
+    return { float(phase - 1), steer };
+}
+
+static bool sameState(const VehicleState& a, const VehicleState& b) {
+    return a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z &&
+           a.facingX == b.facingX && a.facingZ == b.facingZ && a.velocityX == b.velocityX &&
+           a.velocityZ == b.velocityZ && a.steerAngle == b.steerAngle;
+}
+
+int main() {
+    const GameSettings settings;
+    const VehicleParameters parameters = makeVehicleParameters(settings);
+
+    VehicleBatch batch(parameters, settings.physicsStepRate, settings.maxPhysicsStepsPerFrame);
+    FixedStepper stepper(settings.physicsStepRate, settings.maxPhysicsStepsPerFrame);
+    std::vector<VehicleState> vehicles;
+
+    for (int i = 0; i < numVehicles; i++) {
+        VehicleState state = makeVehicleState({ float(i) * 5.0f, 0.0f, float(i % 3) * -4.0f }, float(i) * 33.0f);
+        state.velocityX = float(i % 4) * 3.0f;
+        vehicles.push_back(state);
+        batch.AddVehicle(state);
+    }
+
+    for (int frame = 0; frame < numFrames; frame++) {
+        // Uneven frame times, so some frames run no steps and some run several
+        float frameTime = (frame % 5 == 0) ? 0.004f : 1.0f / float(30 + frame % 60);
+
+        for (int i = 0; i < numVehicles; i++) {
+            batch.SetControls(i, makeTestControls(i, frame));
+        }
+        batch.Step(frameTime);
+
+        int steps = stepper.Advance(frameTime);
+        for (int step = 0; step < steps; step++) {
+            for (int i = 0; i < numVehicles; i++) {
+                integrateVehicle(parameters, makeTestControls(i, frame), vehicles[i], stepper.GetStepTime());
+            }
+        }
+
+        for (int i = 0; i < numVehicles; i++) {
+            if (!sameState(batch.GetVehicle(i), vehicles[i])) {
+                std::printf("FAILED: vehicle %d differs from integrateVehicle after frame %d\n", i, frame);
+                return 1;
+            }
+        }
+    }
+
+    std::printf("VehicleBatch matches integrateVehicle for %d vehicles over %d frames\n", numVehicles, numFrames);
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Offline reader for the gameplay telemetry log, prints totals for scoring, tree damage, hit sides and how long
+// moving enemies took to reset.
+//
+//   TelemetryReader telemetry.bin
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../Telemetry.h"
+
+static const char* eventTypeNames[NUM_TELEMETRY_EVENT_TYPES] = {
+    "tree hit",
+    "static car hit",
+    "moving car hit",
+    "moving car reset",
+    "game over",
+    "game restart"
+};
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::printf("Usage: %s <telemetry log>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<TelemetryEvent> events;
+    if (!readTelemetryLog(argv[1], events)) {
+        std::printf("Could not read telemetry log %s\n", argv[1]);
+        return 1;
+    }
+
+    int eventCounts[NUM_TELEMETRY_EVENT_TYPES] = {};
+    int healthLostToTrees = 0;
+    int scoreGained = 0;
+    int scoreLost = 0;
+    int frontHits = 0;
+    int sideHits = 0;
+    int contacts = 0;
+
+    // Time each moving enemy was hit for scoring, negative while it is moving
+    std::vector<float> hitTimes;
+    std::vector<float> resetDurations;
+
+    for (const TelemetryEvent& event : events) {
+        if (event.type < NUM_TELEMETRY_EVENT_TYPES) {
+            eventCounts[event.type]++;
+        }
+
+        if (event.scoreChange > 0) {
+            scoreGained += event.scoreChange;
+        }
+        else {
+            scoreLost -= event.scoreChange;
+        }
+
+        switch (event.type) {
+        case TELEMETRY_TREE_HIT:
+            healthLostToTrees -= event.healthChange;
+            break;
+
+        case TELEMETRY_STATIC_CAR_HIT:
+        case TELEMETRY_MOVING_CAR_HIT:
+            contacts++;
+
+            // Only the first hit on a car scores, later contacts are just bumps
+            if (event.scoreChange != 0) {
+                if (event.hitSide == HIT_FRONT) {
+                    frontHits++;
+                }
+                else if (event.hitSide == HIT_SIDE) {
+                    sideHits++;
+                }
+
+                if (event.type == TELEMETRY_MOVING_CAR_HIT && event.index >= 0) {
+                    if (int(hitTimes.size()) <= event.index) {
+                        hitTimes.resize(event.index + 1, -1.0f);
+                    }
+                    hitTimes[event.index] = event.time;
+                }
+            }
+            break;
+
+        case TELEMETRY_MOVING_CAR_RESET:
+            if (event.index >= 0 && event.index < int(hitTimes.size()) && hitTimes[event.index] >= 0.0f) {
+                resetDurations.push_back(event.time - hitTimes[event.index]);
+                hitTimes[event.index] = -1.0f;
+            }
+            break;
+
+        case TELEMETRY_GAME_RESTART:
+            std::fill(hitTimes.begin(), hitTimes.end(), -1.0f);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    std::printf("Events: %zu\n", events.size());
+    for (int i = 0; i < NUM_TELEMETRY_EVENT_TYPES; i++) {
+        std::printf("  %-18s %d\n", eventTypeNames[i], eventCounts[i]);
+    }
+
+    std::printf("Score gained: %d, lost: %d", scoreGained, scoreLost);
+    if (!events.empty()) {
+        std::printf(", final: %d", int(events.back().score));
+    }
+    std::printf("\n");
+
+    std::printf("Health lost to trees: %d\n", healthLostToTrees);
+    std::printf("Scoring hits: %d front, %d side (%d contacts in total)\n", frontHits, sideHits, contacts);
+
+    if (!resetDurations.empty()) {
+        float total = 0.0f;
+        for (float duration : resetDurations) {
+            total += duration;
+        }
+        std::printf("Enemy resets: %zu, average %.2f s, min %.2f s, max %.2f s\n", resetDurations.size(),
+                    total / resetDurations.size(),
+                    *std::min_element(resetDurations.begin(), resetDurations.end()),
+                    *std::max_element(resetDurations.begin(), resetDurations.end()));
+    }
+    else {
+        std::printf("Enemy resets: 0\n");
+    }
+
+    return 0;
+}
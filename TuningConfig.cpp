@@ -0,0 +1,210 @@
+#include "TuningConfig.h"
+
+#ifndef GAME_TUNING_BAKED
+
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+enum TuningResult {
+    TUNING_SET,
+    TUNING_BAD_VALUE,
+    TUNING_OUT_OF_RANGE,
+    TUNING_UNKNOWN_NAME
+};
+
+static std::string trim(const std::string& text) {
+    const char* whitespace = " \t\r\n";
+    size_t first = text.find_first_not_of(whitespace);
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = text.find_last_not_of(whitespace);
+    return text.substr(first, last - first + 1);
+}
+
+// The whole value has to be a number, so a typo like "3.0f" or "1O" is reported rather than half read
+static bool parseTuningValue(const std::string& text, float& value) {
+    char* end = nullptr;
+    errno = 0;
+    float parsed = std::strtof(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || errno == ERANGE) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+static bool parseTuningValue(const std::string& text, int& value) {
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || errno == ERANGE || parsed != long(int(parsed))) {
+        return false;
+    }
+    value = int(parsed);
+    return true;
+}
+
+// Range of a parameter for error messages, written the way it would be in the config file
+template <typename Type>
+static std::string formatTuningRange(Type minValue, Type maxValue) {
+    std::ostringstream range;
+    range << minValue << " to " << maxValue;
+    return range.str();
+}
+
+// Parse the value and set it only when it is inside the parameter's range, so a value the game cannot run with
+// (a wheel base or step rate of 0) is reported like a typo instead of reaching the simulation
+template <typename Type>
+static TuningResult setTuningValue(const std::string& text, Type& value, Type minValue, Type maxValue) {
+    Type parsed;
+    if (!parseTuningValue(text, parsed)) {
+        return TUNING_BAD_VALUE;
+    }
+    if (!(parsed >= minValue && parsed <= maxValue)) {
+        return TUNING_OUT_OF_RANGE;
+    }
+    value = parsed;
+    return TUNING_SET;
+}
+
+// Look the name up in the tuning table and parse the value into the matching setting
+static TuningResult setTuningValue(GameSettings& settings, const std::string& name, const std::string& value,
+                                   std::string& range) {
+#define SET_TUNING_PARAMETER(type, parameterName, defaultValue, minValue, maxValue)                     \
+    if (name == #parameterName) {                                                                       \
+        range = formatTuningRange<type>(minValue, maxValue);                                            \
+        return setTuningValue<type>(value, settings.parameterName, minValue, maxValue);                 \
+    }
+    GAME_TUNING_PARAMETERS(SET_TUNING_PARAMETER)
+#undef SET_TUNING_PARAMETER
+
+    return TUNING_UNKNOWN_NAME;
+}
+
+bool loadTuningConfig(const std::string& path, GameSettings& settings, std::string& errors) {
+    errors.clear();
+
+    // No file means nothing to override, which is how the game ships
+    std::error_code error;
+    if (!std::filesystem::exists(path, error)) {
+        return true;
+    }
+
+    std::ifstream file(path);
+    if (!file) {
+        errors = path + ": cannot open file\n";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        line = trim(line);
+        if (line.empty()) {
+            continue;
+        }
+
+        std::string location = path + ":" + std::to_string(lineNumber) + ": ";
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            errors += location + "expected name = value\n";
+            continue;
+        }
+
+        std::string name = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+
+        std::string range;
+        switch (setTuningValue(settings, name, value, range)) {
+        case TUNING_SET:
+            break;
+        case TUNING_BAD_VALUE:
+            errors += location + "bad value '" + value + "' for " + name + "\n";
+            break;
+        case TUNING_OUT_OF_RANGE:
+            errors += location + name + " = " + value + " is outside its range of " + range + "\n";
+            break;
+        case TUNING_UNKNOWN_NAME:
+            errors += location + "unknown setting " + name + "\n";
+            break;
+        }
+    }
+
+    return errors.empty();
+}
+
+TuningWatcher::TuningWatcher(const std::string& path, std::chrono::milliseconds pollInterval)
+    : path(path), pollInterval(pollInterval) {
+}
+
+TuningWatcher::~TuningWatcher() {
+    Stop();
+}
+
+void TuningWatcher::Start() {
+    if (running.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    lastWriteTime = GetWriteTime();
+    running.store(true, std::memory_order_relaxed);
+    watcher = std::thread(&TuningWatcher::WatchLoop, this);
+}
+
+void TuningWatcher::Stop() {
+    if (!running.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        running.store(false, std::memory_order_relaxed);
+    }
+    stopSignal.notify_one();
+    watcher.join();
+}
+
+// A missing file reads as the oldest possible time, so creating or deleting it counts as a change
+std::filesystem::file_time_type TuningWatcher::GetWriteTime() const {
+    std::error_code error;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type::min() : writeTime;
+}
+
+void TuningWatcher::WatchLoop() {
+    std::unique_lock<std::mutex> stopLock(stopMutex);
+
+    while (running.load(std::memory_order_relaxed)) {
+        stopSignal.wait_for(stopLock, pollInterval);
+
+        std::filesystem::file_time_type writeTime = GetWriteTime();
+        if (writeTime == lastWriteTime) {
+            continue;
+        }
+        lastWriteTime = writeTime;
+
+        // Values taken out of the file go back to their defaults, and all of them do when the file is deleted
+        GameSettings settings;
+        std::string loadErrors;
+        bool loaded = loadTuningConfig(path, settings, loadErrors);
+
+        std::lock_guard<std::mutex> lock(settingsMutex);
+        errors = loadErrors;
+        errorsChanged.store(true, std::memory_order_release);
+        if (loaded) {
+            pendingSettings = settings;
+            settingsReady.store(true, std::memory_order_release);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+
+#ifndef GAME_TUNING_BAKED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "GameWorld.h"
+
+// Read tuning values from a config file of "name = value" lines, anything after a # is a comment. Names are the
+// ones in GameTuning.h, values the file does not mention keep what settings already holds. A missing file is not an
+// error and leaves settings as they are. Returns false if the file cannot be opened or has lines that cannot be
+// used, with one message per bad line in errors.
+bool loadTuningConfig(const std::string& path, GameSettings& settings, std::string& errors);
+
+// Watches the tuning config file from a background thread. When the file changes it is read into a fresh set of
+// settings, which the game loop picks up with TakeSettings between frames so a step never sees half a reload.
+// A file with errors is not used, the game keeps its current settings until the file is fixed.
+class TuningWatcher {
+public:
+    explicit TuningWatcher(const std::string& path, std::chrono::milliseconds pollInterval = std::chrono::milliseconds(250));
+    ~TuningWatcher();
+
+    TuningWatcher(const TuningWatcher&) = delete;
+    TuningWatcher& operator=(const TuningWatcher&) = delete;
+
+    // Start watching, changes made before this call are not reported
+    void Start();
+    void Stop();
+
+    // Called from the game loop, copies out the settings from the latest reload and returns true, or returns
+    // false straight away when nothing has changed since the last call
+    bool TakeSettings(GameSettings& settings) {
+        if (!settingsReady.load(std::memory_order_acquire)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(settingsMutex);
+        settings = pendingSettings;
+        settingsReady.store(false, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Copies out the problems found in the last version of the file that was read (empty when it loaded cleanly)
+    // and returns true, or returns false straight away when they have not changed since the last call
+    bool TakeErrors(std::string& loadErrors) {
+        if (!errorsChanged.load(std::memory_order_acquire)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(settingsMutex);
+        loadErrors = errors;
+        errorsChanged.store(false, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    void WatchLoop();
+    std::filesystem::file_time_type GetWriteTime() const;
+
+    std::string path;
+    std::chrono::milliseconds pollInterval;
+    std::filesystem::file_time_type lastWriteTime;
+
+    std::thread watcher;
+    std::atomic<bool> running{ false };
+    std::mutex stopMutex;
+    std::condition_variable stopSignal;
+
+    std::mutex settingsMutex;
+    std::atomic<bool> settingsReady{ false };
+    std::atomic<bool> errorsChanged{ false };
+    GameSettings pendingSettings;
+    std::string errors;
+};
+
+#endif
@@ -0,0 +1,309 @@
+#include "VehicleDynamics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef GAME_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// Vehicles are pushed this little bit clear of what they hit, so resting against an obstacle is not a new contact
+static const float contactSlop = 0.001f;
+
+// Speed the grip limit on turning is worked out at when slower than this, avoids dividing by a speed close to zero
+static const float minGripSpeed = 0.5f;
+
+// tan for steering angles, the series is within 0.2% of tan up to 30 degrees and needs no library call
+static inline float steeringTan(float angle) {
+    float angleSquared = angle * angle;
+    return angle * (1.0f + angleSquared * (1.0f / 3.0f + angleSquared * (2.0f / 15.0f)));
+}
+
+static inline float moveTowards(float value, float target, float maxChange) {
+    return value + std::min(std::max(target - value, -maxChange), maxChange);
+}
+
+// One fixed step of the bicycle model for a single vehicle, shared by the single and batch versions so they
+// cannot drift apart. Works on plain floats so the batch can pass elements of its arrays straight in.
+static inline void stepVehicle(const VehicleParameters& parameters, float throttle, float steer, float& positionX,
+                               float& positionZ, float& facingX, float& facingZ, float& velocityX, float& velocityZ,
+                               float& steerAngle, float stepTime) {
+    // The front wheels turn towards the steering input at a limited rate rather than snapping to full lock
+    steerAngle = moveTowards(steerAngle, steer * parameters.maxSteerAngle, parameters.steeringSpeed * stepTime);
+
+    // Split the velocity into forward and sideways parts. TL-Engine is left handed, so right of facing (x, z) is (z, -x).
+    float forwardSpeed = velocityX * facingX + velocityZ * facingZ;
+    float sidewaysSpeed = velocityX * facingZ - velocityZ * facingX;
+
+    // Longitudinal tyre force, engine and brakes while the throttle is held, rolling friction when it is not.
+    // Written as selects rather than branches so the batch loop vectorises; a car already past the top speed
+    // (after being shoved by another car) is not pulled back to it by the throttle.
+    float driven = forwardSpeed + parameters.acceleration * throttle * stepTime;
+    float forwardDriven = std::max(forwardSpeed, std::min(driven, parameters.maxForwardSpeed));
+    float backwardDriven = std::min(forwardSpeed, std::max(driven, parameters.maxBackwardSpeed));
+    float coasting = moveTowards(forwardSpeed, 0.0f, parameters.deceleration * stepTime);
+    forwardSpeed = (throttle > 0.0f) ? forwardDriven : ((throttle < 0.0f) ? backwardDriven : coasting);
+
+    // Lateral tyre friction, sideways sliding left over from a bounce dies away at up to the grip limit
+    sidewaysSpeed = moveTowards(sidewaysSpeed, 0.0f, parameters.lateralGrip * stepTime);
+
+    // Bicycle model yaw rate, forward speed * tan(steer angle) / wheel base. The tyres cannot turn the car
+    // harder than their grip allows, so at speed the car runs wide instead of turning on the spot.
+    float yawRate = forwardSpeed * steeringTan(steerAngle * degreesToRadians) / parameters.wheelBase;
+    float maxYawRate = parameters.lateralGrip / std::max(std::fabs(forwardSpeed), minGripSpeed);
+    yawRate = std::min(std::max(yawRate, -maxYawRate), maxYawRate);
+
+    // Rotate the facing vector by the small yaw for this step without trig. The rotated vector is within a hair
+    // of unit length, so one Newton step of 1 / sqrt from 1 renormalises it without a library call.
+    float angle = yawRate * stepTime;
+    float sinAngle = angle - angle * angle * angle * (1.0f / 6.0f);
+    float cosAngle = 1.0f - angle * angle * 0.5f;
+    float newFacingX = facingX * cosAngle + facingZ * sinAngle;
+    float newFacingZ = facingZ * cosAngle - facingX * sinAngle;
+    float inverseLength = 1.5f - 0.5f * (newFacingX * newFacingX + newFacingZ * newFacingZ);
+    facingX = newFacingX * inverseLength;
+    facingZ = newFacingZ * inverseLength;
+
+    // The tyres carry the velocity round with the car, then the new velocity moves it (semi-implicit Euler)
+    velocityX = facingX * forwardSpeed + facingZ * sidewaysSpeed;
+    velocityZ = facingZ * forwardSpeed - facingX * sidewaysSpeed;
+    positionX += velocityX * stepTime;
+    positionZ += velocityZ * stepTime;
+}
+
+#ifdef GAME_USE_SSE
+static inline __m128 select4(__m128 mask, __m128 ifTrue, __m128 ifFalse) {
+    return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+static inline __m128 moveTowards4(__m128 value, __m128 target, __m128 maxChange) {
+    __m128 change = _mm_sub_ps(target, value);
+    return _mm_add_ps(value, _mm_min_ps(_mm_max_ps(change, _mm_sub_ps(_mm_setzero_ps(), maxChange)), maxChange));
+}
+
+// stepVehicle for four vehicles at once, the sums are done in the same order so both versions give the same result
+// (checked by Tests/VehicleBatchTest.cpp). That only holds with strict floating point, /fp:fast may reorder them.
+static void stepVehicles4(const VehicleParameters& parameters, const float* throttle, const float* steer, float* positionX,
+                          float* positionZ, float* facingX, float* facingZ, float* velocityX, float* velocityZ,
+                          float* steerAngle, float stepTime) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 dt = _mm_set1_ps(stepTime);
+    const __m128 absoluteMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+    __m128 throttles = _mm_loadu_ps(throttle);
+    __m128 fx = _mm_loadu_ps(facingX);
+    __m128 fz = _mm_loadu_ps(facingZ);
+    __m128 vx = _mm_loadu_ps(velocityX);
+    __m128 vz = _mm_loadu_ps(velocityZ);
+
+    __m128 targetAngle = _mm_mul_ps(_mm_loadu_ps(steer), _mm_set1_ps(parameters.maxSteerAngle));
+    __m128 angle = moveTowards4(_mm_loadu_ps(steerAngle), targetAngle, _mm_set1_ps(parameters.steeringSpeed * stepTime));
+
+    __m128 forwardSpeed = _mm_add_ps(_mm_mul_ps(vx, fx), _mm_mul_ps(vz, fz));
+    __m128 sidewaysSpeed = _mm_sub_ps(_mm_mul_ps(vx, fz), _mm_mul_ps(vz, fx));
+
+    __m128 driven = _mm_add_ps(forwardSpeed, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(parameters.acceleration), throttles), dt));
+    __m128 forwardDriven = _mm_max_ps(forwardSpeed, _mm_min_ps(driven, _mm_set1_ps(parameters.maxForwardSpeed)));
+    __m128 backwardDriven = _mm_min_ps(forwardSpeed, _mm_max_ps(driven, _mm_set1_ps(parameters.maxBackwardSpeed)));
+    __m128 coasting = moveTowards4(forwardSpeed, zero, _mm_set1_ps(parameters.deceleration * stepTime));
+    forwardSpeed = select4(_mm_cmpgt_ps(throttles, zero), forwardDriven,
+                           select4(_mm_cmplt_ps(throttles, zero), backwardDriven, coasting));
+
+    sidewaysSpeed = moveTowards4(sidewaysSpeed, zero, _mm_set1_ps(parameters.lateralGrip * stepTime));
+
+    __m128 radians = _mm_mul_ps(angle, _mm_set1_ps(degreesToRadians));
+    __m128 radiansSquared = _mm_mul_ps(radians, radians);
+    __m128 tanAngle = _mm_mul_ps(radians, _mm_add_ps(one, _mm_mul_ps(radiansSquared,
+                                 _mm_add_ps(_mm_set1_ps(1.0f / 3.0f), _mm_mul_ps(radiansSquared, _mm_set1_ps(2.0f / 15.0f))))));
+    __m128 yawRate = _mm_div_ps(_mm_mul_ps(forwardSpeed, tanAngle), _mm_set1_ps(parameters.wheelBase));
+    __m128 gripSpeed = _mm_max_ps(_mm_and_ps(forwardSpeed, absoluteMask), _mm_set1_ps(minGripSpeed));
+    __m128 maxYawRate = _mm_div_ps(_mm_set1_ps(parameters.lateralGrip), gripSpeed);
+    yawRate = _mm_min_ps(_mm_max_ps(yawRate, _mm_sub_ps(zero, maxYawRate)), maxYawRate);
+
+    __m128 yaw = _mm_mul_ps(yawRate, dt);
+    __m128 yawSquared = _mm_mul_ps(yaw, yaw);
+    __m128 sinAngle = _mm_sub_ps(yaw, _mm_mul_ps(_mm_mul_ps(yawSquared, yaw), _mm_set1_ps(1.0f / 6.0f)));
+    __m128 cosAngle = _mm_sub_ps(one, _mm_mul_ps(yawSquared, _mm_set1_ps(0.5f)));
+    __m128 newFacingX = _mm_add_ps(_mm_mul_ps(fx, cosAngle), _mm_mul_ps(fz, sinAngle));
+    __m128 newFacingZ = _mm_sub_ps(_mm_mul_ps(fz, cosAngle), _mm_mul_ps(fx, sinAngle));
+    __m128 lengthSquared = _mm_add_ps(_mm_mul_ps(newFacingX, newFacingX), _mm_mul_ps(newFacingZ, newFacingZ));
+    __m128 inverseLength = _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_set1_ps(0.5f), lengthSquared));
+    fx = _mm_mul_ps(newFacingX, inverseLength);
+    fz = _mm_mul_ps(newFacingZ, inverseLength);
+
+    vx = _mm_add_ps(_mm_mul_ps(fx, forwardSpeed), _mm_mul_ps(fz, sidewaysSpeed));
+    vz = _mm_sub_ps(_mm_mul_ps(fz, forwardSpeed), _mm_mul_ps(fx, sidewaysSpeed));
+
+    _mm_storeu_ps(positionX, _mm_add_ps(_mm_loadu_ps(positionX), _mm_mul_ps(vx, dt)));
+    _mm_storeu_ps(positionZ, _mm_add_ps(_mm_loadu_ps(positionZ), _mm_mul_ps(vz, dt)));
+    _mm_storeu_ps(facingX, fx);
+    _mm_storeu_ps(facingZ, fz);
+    _mm_storeu_ps(velocityX, vx);
+    _mm_storeu_ps(velocityZ, vz);
+    _mm_storeu_ps(steerAngle, angle);
+}
+#endif
+
+// Move the vehicle out along the contact normal and remove the closing speed, keeping the restitution fraction of it
+static void applyContact(const VehicleParameters& parameters, VehicleState& state, float normalX, float normalZ,
+                         float penetration, const Vector3& obstacleVelocity) {
+    state.position.x += normalX * (penetration + contactSlop);
+    state.position.z += normalZ * (penetration + contactSlop);
+
+    float closingSpeed = (state.velocityX - obstacleVelocity.x) * normalX + (state.velocityZ - obstacleVelocity.z) * normalZ;
+    if (closingSpeed < 0.0f) {
+        float impulse = -(1.0f + parameters.restitution) * closingSpeed;
+        state.velocityX += impulse * normalX;
+        state.velocityZ += impulse * normalZ;
+    }
+}
+
+VehicleState makeVehicleState(const Vector3& position, float rotationY) {
+    Vector3 facing = calculateFacingVector(rotationY);
+    return { position, facing.x, facing.z, 0.0f, 0.0f, 0.0f };
+}
+
+float calculateVehicleRotationY(const VehicleState& state) {
+    return std::atan2(state.facingX, state.facingZ) / degreesToRadians;
+}
+
+float calculateForwardSpeed(const VehicleState& state) {
+    return state.velocityX * state.facingX + state.velocityZ * state.facingZ;
+}
+
+void integrateVehicle(const VehicleParameters& parameters, const VehicleControls& controls, VehicleState& state, float stepTime) {
+    stepVehicle(parameters, controls.throttle, controls.steer, state.position.x, state.position.z, state.facingX, state.facingZ,
+                state.velocityX, state.velocityZ, state.steerAngle, stepTime);
+}
+
+bool resolveCircleContact(const VehicleParameters& parameters, VehicleState& state, const Vector3& centre, float radius) {
+    float offsetX = state.position.x - centre.x;
+    float offsetZ = state.position.z - centre.z;
+    float collisionDistance = parameters.radius + radius;
+    float distanceSquared = offsetX * offsetX + offsetZ * offsetZ;
+
+    if (distanceSquared >= collisionDistance * collisionDistance) {
+        return false;
+    }
+
+    // Dead centre has no direction to push in, so push the vehicle back the way it is facing
+    float distance = std::sqrt(distanceSquared);
+    float normalX = -state.facingX;
+    float normalZ = -state.facingZ;
+    if (distance > 0.0f) {
+        normalX = offsetX / distance;
+        normalZ = offsetZ / distance;
+    }
+
+    applyContact(parameters, state, normalX, normalZ, collisionDistance - distance, { 0.0f, 0.0f, 0.0f });
+    return true;
+}
+
+bool resolveBoxContact(const VehicleParameters& parameters, VehicleState& state, const Vector3& centre, const BoundingBox& box,
+                       const Vector3& obstacleVelocity) {
+    float localX = state.position.x - centre.x;
+    float localZ = state.position.z - centre.z;
+
+    // Closest point of the box to the vehicle on the ground plane
+    float closestX = std::min(std::max(localX, box.minX), box.maxX);
+    float closestZ = std::min(std::max(localZ, box.minZ), box.maxZ);
+    float offsetX = localX - closestX;
+    float offsetZ = localZ - closestZ;
+    float distanceSquared = offsetX * offsetX + offsetZ * offsetZ;
+
+    if (distanceSquared >= parameters.radius * parameters.radius) {
+        return false;
+    }
+
+    float normalX;
+    float normalZ;
+    float penetration;
+
+    if (distanceSquared > 0.0f) {
+        float distance = std::sqrt(distanceSquared);
+        normalX = offsetX / distance;
+        normalZ = offsetZ / distance;
+        penetration = parameters.radius - distance;
+    }
+    else {
+        // Centre inside the box, push out through the nearest face
+        float faceDistances[4] = { localX - box.minX, box.maxX - localX, localZ - box.minZ, box.maxZ - localZ };
+        int nearestFace = int(std::min_element(faceDistances, faceDistances + 4) - faceDistances);
+        static const float faceNormals[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+        normalX = faceNormals[nearestFace][0];
+        normalZ = faceNormals[nearestFace][1];
+        penetration = faceDistances[nearestFace] + parameters.radius;
+    }
+
+    applyContact(parameters, state, normalX, normalZ, penetration, obstacleVelocity);
+    return true;
+}
+
+FixedStepper::FixedStepper(float stepRate, int maxStepsPerFrame)
+    : stepTime(1.0f / stepRate), maxStepsPerFrame(maxStepsPerFrame) {
+}
+
+int FixedStepper::Advance(float frameTime) {
+    accumulator += frameTime;
+
+    int steps = int(accumulator / stepTime);
+    if (steps > maxStepsPerFrame) {
+        // Drop the time that cannot be caught up on, the game slows down rather than stalling
+        steps = maxStepsPerFrame;
+        accumulator = 0.0f;
+    }
+    else {
+        accumulator -= steps * stepTime;
+    }
+    return steps;
+}
+
+VehicleBatch::VehicleBatch(const VehicleParameters& parameters, float stepRate, int maxStepsPerFrame)
+    : parameters(parameters), stepper(stepRate, maxStepsPerFrame) {
+}
+
+int VehicleBatch::AddVehicle(const VehicleState& state) {
+    positionX.push_back(state.position.x);
+    positionY.push_back(state.position.y);
+    positionZ.push_back(state.position.z);
+    facingX.push_back(state.facingX);
+    facingZ.push_back(state.facingZ);
+    velocityX.push_back(state.velocityX);
+    velocityZ.push_back(state.velocityZ);
+    steerAngle.push_back(state.steerAngle);
+    throttle.push_back(0.0f);
+    steer.push_back(0.0f);
+    return int(positionX.size()) - 1;
+}
+
+void VehicleBatch::SetControls(int vehicle, const VehicleControls& controls) {
+    throttle[vehicle] = controls.throttle;
+    steer[vehicle] = controls.steer;
+}
+
+VehicleState VehicleBatch::GetVehicle(int vehicle) const {
+    return { { positionX[vehicle], positionY[vehicle], positionZ[vehicle] }, facingX[vehicle], facingZ[vehicle],
+             velocityX[vehicle], velocityZ[vehicle], steerAngle[vehicle] };
+}
+
+void VehicleBatch::Step(float frameTime) {
+    const int steps = stepper.Advance(frameTime);
+    const float stepTime = stepper.GetStepTime();
+    const int count = GetVehicleCount();
+
+    // Vehicles do not affect each other, so each step is one pass over the arrays doing four vehicles at a time
+    for (int step = 0; step < steps; step++) {
+        int i = 0;
+#ifdef GAME_USE_SSE
+        for (; i + 4 <= count; i += 4) {
+            stepVehicles4(parameters, &throttle[i], &steer[i], &positionX[i], &positionZ[i], &facingX[i], &facingZ[i],
+                          &velocityX[i], &velocityZ[i], &steerAngle[i], stepTime);
+        }
+#endif
+        for (; i < count; i++) {
+            stepVehicle(parameters, throttle[i], steer[i], positionX[i], positionZ[i], facingX[i], facingZ[i],
+                        velocityX[i], velocityZ[i], steerAngle[i], stepTime);
+        }
+    }
+}
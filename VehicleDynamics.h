@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+
+#include "GameMath.h"
+
+// Handling of a vehicle, speeds in units per second and angles in degrees
+struct VehicleParameters {
+    float acceleration;         // change in forward speed per second with the throttle held
+    float deceleration;         // rolling friction slowing the car when the throttle is released
+    float maxForwardSpeed;
+    float maxBackwardSpeed;     // negative
+    float wheelBase;            // distance between front and rear axles in the bicycle model
+    float lateralGrip;          // most sideways acceleration the tyres can give before sliding
+    float maxSteerAngle;
+    float steeringSpeed;        // how fast the front wheels turn towards the steering input
+    float restitution;          // fraction of the closing speed kept when bouncing off an obstacle
+    float radius;               // collision radius
+};
+
+// Driver input, throttle from -1 (reverse) to 1 (forward) and steer from -1 (left) to 1 (right)
+struct VehicleControls {
+    float throttle;
+    float steer;
+};
+
+// State of one vehicle on the ground plane. Facing is a unit vector, TL-Engine's local z axis for the model.
+struct VehicleState {
+    Vector3 position;
+    float facingX;
+    float facingZ;
+    float velocityX;
+    float velocityZ;
+    float steerAngle;
+};
+
+// Put a vehicle at a position, at rest and facing along the given y rotation in degrees
+VehicleState makeVehicleState(const Vector3& position, float rotationY);
+
+// Rotation about the y axis in degrees that gives the vehicle's facing, for setting the model orientation
+float calculateVehicleRotationY(const VehicleState& state);
+
+// Speed along the direction the vehicle is facing, negative when reversing
+float calculateForwardSpeed(const VehicleState& state);
+
+// Advance one vehicle by one fixed step using semi-implicit Euler (velocity first, then position)
+void integrateVehicle(const VehicleParameters& parameters, const VehicleControls& controls, VehicleState& state, float stepTime);
+
+// Push the vehicle out of a circular obstacle and apply a bounce impulse, returns true if they were touching
+bool resolveCircleContact(const VehicleParameters& parameters, VehicleState& state, const Vector3& centre, float radius);
+
+// Push the vehicle out of a box obstacle that may be moving and apply a bounce impulse, returns true if they were touching
+bool resolveBoxContact(const VehicleParameters& parameters, VehicleState& state, const Vector3& centre, const BoundingBox& box,
+                       const Vector3& obstacleVelocity);
+
+// Splits a variable frame time into fixed steps, carrying the remainder over to the next frame
+class FixedStepper {
+public:
+    FixedStepper(float stepRate, int maxStepsPerFrame);
+
+    // Number of fixed steps to run for this frame, capped so a long frame cannot snowball into a longer one
+    int Advance(float frameTime);
+
+    float GetStepTime() const { return stepTime; }
+    void Reset() { accumulator = 0.0f; }
+
+private:
+    float stepTime;
+    int maxStepsPerFrame;
+    float accumulator = 0.0f;
+};
+
+// Many vehicles sharing the same handling, stored as structure-of-arrays for batch simulation of AI traffic
+class VehicleBatch {
+public:
+    VehicleBatch(const VehicleParameters& parameters, float stepRate, int maxStepsPerFrame);
+
+    int AddVehicle(const VehicleState& state);
+    void SetControls(int vehicle, const VehicleControls& controls);
+    VehicleState GetVehicle(int vehicle) const;
+    int GetVehicleCount() const { return int(positionX.size()); }
+
+    // Advance every vehicle by the fixed steps that fit in the frame
+    void Step(float frameTime);
+
+private:
+    VehicleParameters parameters;
+    FixedStepper stepper;
+
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> positionZ;
+    std::vector<float> facingX;
+    std::vector<float> facingZ;
+    std::vector<float> velocityX;
+    std::vector<float> velocityZ;
+    std::vector<float> steerAngle;
+    std::vector<float> throttle;
+    std::vector<float> steer;
+};